@@ -0,0 +1,63 @@
+# Benchmark of the fractal engines
+#
+# Builds command line program, which times Mandelbrot kernels,
+# tile renderer, image file writers and Sierpinski geometry over fixed workloads and
+# writes text, CSV and JSON reports, so regressions can be tracked
+# from run to run. It uses engine sources of the GUI programs
+# (../Mandelbrot/src, ../Sierpinski/src), without Stanford C++
+# library and its Java back end.
+#
+# Engine sources are listed one by one: their folders have GUI programs too.
+#
+# @version 2026/10/17
+# - first version
+# - image file writers (buffered and memory mapped)
+
+TEMPLATE = app
+TARGET = Benchmark
+CONFIG += console
+CONFIG -= qt app_bundle
+
+MANDELBROT = $$PWD/../Mandelbrot/src
+SIERPINSKI = $$PWD/../Sierpinski/src
+
+SOURCES += $$PWD/src/Benchmark.cpp
+SOURCES += $$MANDELBROT/imagewriter.cpp
+SOURCES += $$MANDELBROT/mandelbrotkernel.cpp
+SOURCES += $$MANDELBROT/palette.cpp
+SOURCES += $$MANDELBROT/tilerenderer.cpp
+SOURCES += $$MANDELBROT/workpool.cpp
+SOURCES += $$SIERPINSKI/sierpinskigeometry.cpp
+
+HEADERS += $$MANDELBROT/doubledouble.h
+HEADERS += $$MANDELBROT/imagewriter.h
+HEADERS += $$MANDELBROT/mandelbrotkernel.h
+HEADERS += $$MANDELBROT/palette.h
+HEADERS += $$MANDELBROT/rastersink.h
+HEADERS += $$MANDELBROT/tileprofile.h
+HEADERS += $$MANDELBROT/tilerenderer.h
+HEADERS += $$MANDELBROT/workpool.h
+HEADERS += $$SIERPINSKI/sierpinskigeometry.h
+
+INCLUDEPATH += $$MANDELBROT/
+INCLUDEPATH += $$SIERPINSKI/
+
+# the same compiler flags as the batch renderer has
+# (see ../Mandelbrot/batch/MandelbrotBatch.pro); benchmark is
+# meaningful only in release build
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS_WARN_ON += -Wall
+QMAKE_CXXFLAGS_WARN_ON += -Wextra
+QMAKE_CXXFLAGS_WARN_ON += -Wno-sign-compare
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
+QMAKE_CXXFLAGS += -pthread
+QMAKE_LFLAGS += -pthread
+QMAKE_CXXFLAGS += -ffp-contract=off
+
+CONFIG(release, debug|release) {
+    QMAKE_CXXFLAGS += -O2
+}
+CONFIG(debug, debug|release) {
+    QMAKE_CXXFLAGS += -O0
+    QMAKE_CXXFLAGS += -g3
+}
@@ -0,0 +1,597 @@
+/********************************************************************************************
+* File: Benchmark.cpp
+* ----------------------
+* v.1 2026/10/17
+* - Mandelbrot kernels of every instruction set and precision, single and
+*   multithreaded tile renderer, Sierpinski geometry over fixed workloads,
+* - warm-up runs and repetitions, best and median time,
+* - text, CSV and JSON reports,
+* - image file output by buffered writer and by memory mapping
+*
+* Command line benchmark of the fractal engines.
+********************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "imagewriter.h"
+#include "mandelbrotkernel.h"
+#include "palette.h"
+#include "sierpinskigeometry.h"
+#include "tilerenderer.h"
+#include "workpool.h"
+
+using namespace std;
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const DEFAULT_WIDTH = 480;
+int const DEFAULT_HEIGHT = 360;
+int const DEFAULT_WARMUP = 1;           /* Runs before measured ones: caches, threads, pages */
+int const DEFAULT_REPETITIONS = 5;
+int const SIERPINSKI_ORDER = 12;        /* 265720 inserted triangles */
+double const SIERPINSKI_LENGTH = 900;
+int const SINK_VIEW = 1;                /* Frame written by sink cases: seahorse-valley */
+int const SINK_TILE_SIZE = 32;          /* Rectangles of mapped file, as TileRenderer tiles */
+const char* const DEFAULT_SINK_FILE = "benchmark-sink.ppm";
+
+/* Type: BenchmarkView
+ * -------------------
+ * Fixed Mandelbrot viewport. Image of any size shows the same
+ * complex area: pixel spacing is width / image width.  */
+struct BenchmarkView {
+    const char* name;
+    double centreRe;
+    double centreIm;
+    double width;           /* Complex width of the image */
+    int maxDepth;
+};
+
+/* Results of different runs are comparable only for the same views,
+ * so they must not be changed - new views can be added */
+BenchmarkView const VIEWS[] = {
+    {"whole-set", -0.7, 0.0, 3.2, 500},                 /* Cardioide and bulb interior */
+    {"seahorse-valley", -0.74364, 0.13182, 0.0016, 3000},   /* Border almost everywhere */
+    {"elephant-valley", 0.282, 0.01, 0.02, 2000},
+    {"minibrot", -1.7549, 0.0, 0.02, 2000},             /* Interior without cardioide test */
+    {"double-double", -0.743643887037151, 0.131825904205330, 1e-11, 1500}
+};
+int const VIEW_COUNT = sizeof(VIEWS) / sizeof(VIEWS[0]);
+
+/* Type: BenchmarkOptions
+ * ----------------------
+ * Parameters of one run, from command line.  */
+struct BenchmarkOptions {
+    int width;
+    int height;
+    int warmup;
+    int repetitions;
+    int threadCount;        /* Threads of multithreaded renderer, 0 - one per core */
+    string csvFile;         /* Empty - no such report */
+    string jsonFile;
+    string sinkFile;        /* Written and removed by sink cases */
+};
+
+/* Type: BenchmarkResult
+ * ---------------------
+ * Measured times of one benchmark case.
+ * Items are pixels for Mandelbrot and triangle sides for
+ * Sierpinski cases; iterations are those made by the kernel for
+ * calculated pixels (as RenderStats counts them) and inserted
+ * triangles.
+ * Sink cases make no iterations, they write bytes of image file.  */
+struct BenchmarkResult {
+    string group;           /* "kernel", "renderer", "sink" or "sierpinski" */
+    string name;
+    string view;
+    int threads;
+    string unit;            /* "pixel" or "side" */
+    long long items;
+    long long iterations;
+    long long bytes;        /* File bytes of sink cases, 0 for others */
+    double bestSeconds;
+    double medianSeconds;
+
+    BenchmarkResult()
+            : threads(1), items(0), iterations(0), bytes(0), bestSeconds(0),
+              medianSeconds(0) {}
+};
+
+/*------------------------------------------------------------------------------------------//
+ * Implementation section.
+ * -----------------------
+ * Kernel cases call calculateMandelbrotPoints for all pixels of
+ * a view at once in the caller's thread, without cardioide test,
+ * symmetry and tiles: they show speed of the instruction sets and
+ * precisions themselves. Precision is the one choosePrecision picks
+ * for the view, "double-double" view is too deep for double.
+ * Renderer cases render the same views by TileRenderer with its
+ * defaults, in one thread and in all threads.
+ * Sink cases write one rendered frame (SINK_VIEW) to PPM file:
+ * by ImageStreamWriter at once, by MappedImageFile at once, and by
+ * MappedImageFile in tiles from all threads, as batch renderer
+ * does with its --mapped option. Time includes open and close.
+ * Sierpinski case makes sides of order SIERPINSKI_ORDER triangle.
+ *
+ * Every case runs warmup times, then repetitions times; rates are
+ * made from the median time, which is less sensitive to single
+ * slow runs than the mean.
+ * -----------------------------------------------------------------------------------------*/
+
+/* Function: printUsage
+ * --------------------
+ * Prints command line parameters.  */
+void printUsage() {
+    cerr << "Usage: Benchmark [options]" << endl
+         << "  --width N             image width, default " << DEFAULT_WIDTH << endl
+         << "  --height N            image height, default " << DEFAULT_HEIGHT << endl
+         << "  --warmup N            runs before measured ones, default " << DEFAULT_WARMUP
+         << endl
+         << "  --repetitions N       measured runs, default " << DEFAULT_REPETITIONS << endl
+         << "  --threads N           threads of multithreaded renderer, default - one per core"
+         << endl
+         << "  --csv FILE            write results as CSV table" << endl
+         << "  --json FILE           write results as JSON document" << endl
+         << "  --sink-file FILE      image file of file writer cases, default "
+         << DEFAULT_SINK_FILE << endl;
+}
+
+/* Function: parseNumber
+ * ---------------------
+ * Converts whole text to number, returns false if it isn't one.  */
+bool parseNumber(const string& text, int& value) {
+    char* end = NULL;
+    long number = strtol(text.c_str(), &end, 10);
+    value = (int) number;
+    return !text.empty() && *end == '\0' && number == value;
+}
+
+/* Function: parseArguments
+ * ------------------------
+ * Fills options from command line, returns false and sets
+ * error for unknown or invalid parameter.  */
+bool parseArguments(int argc, char** argv, BenchmarkOptions& options, string& error) {
+    options.width = DEFAULT_WIDTH;
+    options.height = DEFAULT_HEIGHT;
+    options.warmup = DEFAULT_WARMUP;
+    options.repetitions = DEFAULT_REPETITIONS;
+    options.threadCount = 0;
+    options.sinkFile = DEFAULT_SINK_FILE;
+
+    for (int i = 1; i < argc; i++) {
+        string name = argv[i];
+        if (i + 1 >= argc) {
+            error = "value expected after " + name;
+            return false;
+        }
+        string value = argv[++i];
+        bool valid = true;
+        if (name == "--width") {
+            valid = parseNumber(value, options.width) && options.width > 0;
+        } else if (name == "--height") {
+            valid = parseNumber(value, options.height) && options.height > 0;
+        } else if (name == "--warmup") {
+            valid = parseNumber(value, options.warmup) && options.warmup >= 0;
+        } else if (name == "--repetitions") {
+            valid = parseNumber(value, options.repetitions) && options.repetitions > 0;
+        } else if (name == "--threads") {
+            valid = parseNumber(value, options.threadCount) && options.threadCount >= 0;
+        } else if (name == "--csv") {
+            options.csvFile = value;
+        } else if (name == "--json") {
+            options.jsonFile = value;
+        } else if (name == "--sink-file") {
+            options.sinkFile = value;
+        } else {
+            error = "unknown option " + name;
+            return false;
+        }
+        if (!valid) {
+            error = "invalid value of " + name + ": " + value;
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Function: measure
+ * -----------------
+ * Runs task warmup times, then repetitions times, and sets
+ * the best and the median time of measured runs in result.  */
+template <typename Task>
+void measure(const BenchmarkOptions& options, Task task, BenchmarkResult& result) {
+    for (int i = 0; i < options.warmup; i++) {
+        task();
+    }
+    vector<double> seconds;
+    for (int i = 0; i < options.repetitions; i++) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        task();
+        seconds.push_back(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    sort(seconds.begin(), seconds.end());
+    result.bestSeconds = seconds.front();
+    size_t middle = seconds.size() / 2;
+    result.medianSeconds = (seconds.size() % 2 != 0)
+            ? seconds[middle]
+            : (seconds[middle - 1] + seconds[middle]) / 2;
+}
+
+/* Function: makeFrame
+ * -------------------
+ * Returns frame of the view for image of options size.  */
+FrameGeometry makeFrame(const BenchmarkOptions& options, const BenchmarkView& view) {
+    FrameGeometry frame;
+    frame.width = options.width;
+    frame.height = options.height;
+    frame.step = view.width / options.width;
+    frame.reLeft = view.centreRe - (options.width / 2) * frame.step;
+    frame.imTop = view.centreIm - (options.height / 2) * frame.step;
+    return frame;
+}
+
+/* Function: runKernelCases
+ * ------------------------
+ * Measures calculateMandelbrotPoints with every instruction set of
+ * this CPU, and the best one with periodicity check. Double-double
+ * kernels don't make that check (see KernelOptions), so views of
+ * that precision have no periodicity case.  */
+void runKernelCases(const BenchmarkOptions& options,
+                    const BenchmarkView& view,
+                    vector<BenchmarkResult>& results) {
+    FrameGeometry frame = makeFrame(options, view);
+    double magnitude = max(fabs(frame.reLeft), fabs(frame.imTop));
+    KernelPrecision precision = choosePrecision(frame.step, magnitude);
+    int count = frame.width * frame.height;
+    vector<double> a;
+    vector<double> b;
+    vector<DoubleDouble> exactA;
+    vector<DoubleDouble> exactB;
+    for (int row = 0; row < frame.height; row++) {
+        for (int col = 0; col < frame.width; col++) {
+            if (precision == PRECISION_DOUBLE_DOUBLE) {
+                exactA.push_back(frame.toRealDoubleDouble(col));
+                exactB.push_back(frame.toImaginaryDoubleDouble(row));
+            } else {
+                a.push_back(frame.toRealValue(col));
+                b.push_back(frame.toImaginaryValue(row));
+            }
+        }
+    }
+    vector<int> depths(count);
+
+    vector<KernelOptions> variants;
+    for (int isa = KERNEL_SCALAR; isa <= detectKernelIsa(); isa++) {
+        KernelOptions kernel;
+        kernel.isa = (KernelIsa) isa;
+        variants.push_back(kernel);
+    }
+    if (precision == PRECISION_DOUBLE) {
+        KernelOptions kernel;
+        kernel.periodicityCheck = true;
+        variants.push_back(kernel);
+    }
+
+    for (size_t i = 0; i < variants.size(); i++) {
+        const KernelOptions& kernel = variants[i];
+        BenchmarkResult result;
+        result.group = "kernel";
+        result.name = string(kernelIsaName(kernel.isa)) + "-" + kernelPrecisionName(precision)
+                + (kernel.periodicityCheck ? "-periodicity" : "");
+        result.view = view.name;
+        result.threads = 1;
+        result.unit = "pixel";
+        long long made = 0;
+        measure(options, [&]() {
+            if (precision == PRECISION_DOUBLE_DOUBLE) {
+                made = calculateMandelbrotPoints(&exactA[0], &exactB[0], count, view.maxDepth,
+                                                 &depths[0], kernel);
+            } else {
+                made = calculateMandelbrotPoints(&a[0], &b[0], count, view.maxDepth,
+                                                 &depths[0], kernel);
+            }
+        }, result);
+        result.items = count;
+        result.iterations = made;
+        results.push_back(result);
+    }
+}
+
+/* Function: runRendererCases
+ * --------------------------
+ * Measures TileRenderer in one thread and in options.threadCount
+ * threads (only one case, if they are the same).  */
+void runRendererCases(const BenchmarkOptions& options,
+                      const BenchmarkView& view,
+                      vector<BenchmarkResult>& results) {
+    FrameGeometry frame = makeFrame(options, view);
+    vector<int> depths((size_t) frame.width * frame.height);
+    TileRenderer multithreaded(options.threadCount);
+    TileRenderer singleThread(1);
+    vector<TileRenderer*> renderers(1, &singleThread);
+    if (multithreaded.getThreadCount() > 1) {
+        renderers.push_back(&multithreaded);
+    }
+    for (size_t i = 0; i < renderers.size(); i++) {
+        TileRenderer& renderer = *renderers[i];
+        BenchmarkResult result;
+        result.group = "renderer";
+        result.name = (i == 0) ? "tiles-single-thread" : "tiles-multithreaded";
+        result.view = view.name;
+        result.threads = renderer.getThreadCount();
+        result.unit = "pixel";
+        measure(options, [&]() {
+            renderer.render(frame, view.maxDepth, &depths[0]);
+        }, result);
+        result.items = renderer.getStats().pixels;
+        result.iterations = renderer.getStats().iterations;
+        results.push_back(result);
+    }
+}
+
+/* Function: getFileSize
+ * ---------------------
+ * Returns size of file in bytes, -1 if it can't be read.  */
+long long getFileSize(const string& filename) {
+    ifstream file(filename.c_str(), ios::binary | ios::ate);
+    return file ? (long long) file.tellg() : -1;
+}
+
+/* Function: runSinkCases
+ * ----------------------
+ * Measures writing of SINK_VIEW frame to options.sinkFile by both
+ * image file writers, removes the file. Returns false and sets
+ * error if file can't be written.  */
+bool runSinkCases(const BenchmarkOptions& options,
+                  vector<BenchmarkResult>& results,
+                  string& error) {
+    const BenchmarkView& view = VIEWS[SINK_VIEW];
+    FrameGeometry frame = makeFrame(options, view);
+    vector<int> depths((size_t) frame.width * frame.height);
+    TileRenderer renderer(options.threadCount);
+    renderer.render(frame, view.maxDepth, &depths[0]);
+    vector<int> rgb(depths.size());
+    Palette::makeDefault(view.maxDepth).colorize(&depths[0], (int) depths.size(), &rgb[0]);
+
+    int tileCols = (frame.width + SINK_TILE_SIZE - 1) / SINK_TILE_SIZE;
+    int tileRows = (frame.height + SINK_TILE_SIZE - 1) / SINK_TILE_SIZE;
+    WorkStealingPool pool(options.threadCount);
+    char const* const NAMES[] = {"stream-writer", "mapped-file", "mapped-file-tiles"};
+    for (int i = 0; i < 3; i++) {
+        BenchmarkResult result;
+        result.group = "sink";
+        result.name = NAMES[i];
+        result.view = view.name;
+        result.threads = (i == 2) ? pool.getThreadCount() : 1;
+        result.unit = "pixel";
+        bool written = true;
+        measure(options, [&]() {
+            if (i == 0) {
+                ImageStreamWriter writer;
+                written &= writer.open(options.sinkFile, IMAGE_PPM, frame.width, frame.height,
+                                       error)
+                        && writer.writeRows(&rgb[0], frame.height, error)
+                        && writer.close(error);
+                return;
+            }
+            MappedImageFile file;
+            if (!file.open(options.sinkFile, IMAGE_PPM, frame.width, frame.height, error)) {
+                written = false;
+                return;
+            }
+            if (i == 1) {
+                written &= file.writeRect(0, 0, frame.width, frame.height, &rgb[0], error);
+            } else {
+                vector<bool> tileWritten(tileCols * tileRows, true);
+                vector<string> tileErrors(tileCols * tileRows);
+                pool.run(tileCols * tileRows, [&](int tile, int) {
+                    int left = (tile % tileCols) * SINK_TILE_SIZE;
+                    int top = (tile / tileCols) * SINK_TILE_SIZE;
+                    int width = min(SINK_TILE_SIZE, frame.width - left);
+                    int height = min(SINK_TILE_SIZE, frame.height - top);
+                    vector<int> tileRgb((size_t) width * height);
+                    for (int row = 0; row < height; row++) {
+                        copy(&rgb[(size_t) (top + row) * frame.width + left],
+                             &rgb[(size_t) (top + row) * frame.width + left] + width,
+                             &tileRgb[(size_t) row * width]);
+                    }
+                    tileWritten[tile] = file.writeRect(left, top, width, height, &tileRgb[0],
+                                                       tileErrors[tile]);
+                });
+                for (size_t k = 0; k < tileWritten.size(); k++) {
+                    if (!tileWritten[k]) {
+                        error = tileErrors[k];
+                        written = false;
+                    }
+                }
+            }
+            written &= file.close(error);
+        }, result);
+        result.items = (long long) frame.width * frame.height;
+        result.bytes = getFileSize(options.sinkFile);
+        remove(options.sinkFile.c_str());
+        if (!written || result.bytes < 0) {
+            if (written) {
+                error = "can't read file \"" + options.sinkFile + "\"";
+            }
+            return false;
+        }
+        results.push_back(result);
+    }
+    return true;
+}
+
+/* Function: runSierpinskiCase
+ * ---------------------------
+ * Measures makeSierpinskiTriangle of SIERPINSKI_ORDER.  */
+void runSierpinskiCase(const BenchmarkOptions& options, vector<BenchmarkResult>& results) {
+    vector<TriangleSide> sides;
+    long long triangles = 0;
+    BenchmarkResult result;
+    result.group = "sierpinski";
+    result.name = "geometry";
+    result.view = "order-" + to_string(SIERPINSKI_ORDER);
+    result.threads = 1;
+    result.unit = "side";
+    measure(options, [&]() {
+        triangles = makeSierpinskiTriangle(PlanePoint(SIERPINSKI_LENGTH / 2, 0),
+                                           SIERPINSKI_LENGTH, SIERPINSKI_ORDER, sides);
+    }, result);
+    result.items = sides.size();
+    result.iterations = triangles;
+    results.push_back(result);
+}
+
+/* Function: itemsPerSecond, iterationsPerSecond, nanosecondsPerIteration,
+ *           megabytesPerSecond
+ * ----------------------------------------------------------------------
+ * Rates of result by its median time.  */
+double itemsPerSecond(const BenchmarkResult& result) {
+    return result.items / result.medianSeconds;
+}
+
+double iterationsPerSecond(const BenchmarkResult& result) {
+    return result.iterations / result.medianSeconds;
+}
+
+double nanosecondsPerIteration(const BenchmarkResult& result) {
+    return (result.iterations > 0) ? result.medianSeconds * 1e9 / result.iterations : 0;
+}
+
+double megabytesPerSecond(const BenchmarkResult& result) {
+    return result.bytes / result.medianSeconds / 1e6;
+}
+
+/* Function: printResult
+ * ---------------------
+ * Prints one line of the text report.  */
+void printResult(const BenchmarkResult& result) {
+    cout << left << setw(11) << result.group << setw(28) << result.name
+         << setw(17) << result.view << right << setw(3) << result.threads
+         << fixed << setprecision(4) << setw(10) << result.medianSeconds << " s"
+         << setprecision(2) << setw(10) << itemsPerSecond(result) / 1e6 << " M"
+         << left << setw(6) << result.unit << right
+         << setw(10) << iterationsPerSecond(result) / 1e6 << " Miter/s"
+         << setprecision(3) << setw(9) << nanosecondsPerIteration(result) << " ns/iter";
+    if (result.bytes > 0) {
+        cout << setprecision(1) << setw(9) << megabytesPerSecond(result) << " MB/s";
+    }
+    cout << endl;
+    cout.unsetf(ios::fixed);
+}
+
+/* Function: writeCsv
+ * ------------------
+ * Writes results as CSV table with header line,
+ * returns false and sets error if file can't be written.  */
+bool writeCsv(const string& filename, const vector<BenchmarkResult>& results, string& error) {
+    ofstream file(filename.c_str());
+    file << "group,case,view,threads,unit,items,iterations,best_s,median_s,"
+         << "items_per_s,iterations_per_s,ns_per_iteration,bytes,mb_per_s" << endl;
+    file << setprecision(9);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        file << result.group << "," << result.name << "," << result.view << ","
+             << result.threads << "," << result.unit << "," << result.items << ","
+             << result.iterations << "," << result.bestSeconds << ","
+             << result.medianSeconds << "," << itemsPerSecond(result) << ","
+             << iterationsPerSecond(result) << "," << nanosecondsPerIteration(result) << ","
+             << result.bytes << "," << megabytesPerSecond(result) << endl;
+    }
+    if (!file) {
+        error = "can't write file \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+/* Function: writeJson
+ * -------------------
+ * Writes run parameters and results as JSON document,
+ * returns false and sets error if file can't be written.
+ * Names of cases and views need no escaping.  */
+bool writeJson(const string& filename,
+               const BenchmarkOptions& options,
+               const vector<BenchmarkResult>& results,
+               string& error) {
+    ofstream file(filename.c_str());
+    file << setprecision(9);
+    file << "{" << endl
+         << "  \"width\": " << options.width << "," << endl
+         << "  \"height\": " << options.height << "," << endl
+         << "  \"warmup\": " << options.warmup << "," << endl
+         << "  \"repetitions\": " << options.repetitions << "," << endl
+         << "  \"kernelIsa\": \"" << kernelIsaName(detectKernelIsa()) << "\"," << endl
+         << "  \"results\": [" << endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchmarkResult& result = results[i];
+        file << "    {\"group\": \"" << result.group << "\", \"case\": \"" << result.name
+             << "\", \"view\": \"" << result.view << "\", \"threads\": " << result.threads
+             << ", \"unit\": \"" << result.unit << "\", \"items\": " << result.items
+             << ", \"iterations\": " << result.iterations
+             << ", \"bestSeconds\": " << result.bestSeconds
+             << ", \"medianSeconds\": " << result.medianSeconds
+             << ", \"itemsPerSecond\": " << itemsPerSecond(result)
+             << ", \"iterationsPerSecond\": " << iterationsPerSecond(result)
+             << ", \"nsPerIteration\": " << nanosecondsPerIteration(result)
+             << ", \"bytes\": " << result.bytes
+             << ", \"megabytesPerSecond\": " << megabytesPerSecond(result) << "}"
+             << ((i + 1 < results.size()) ? "," : "") << endl;
+    }
+    file << "  ]" << endl << "}" << endl;
+    if (!file) {
+        error = "can't write file \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions options;
+    string error;
+    if (!parseArguments(argc, argv, options, error)) {
+        cerr << "Benchmark: " << error << endl;
+        printUsage();
+        return 1;
+    }
+    cout << options.width << "x" << options.height << ", warm-up " << options.warmup
+         << ", repetitions " << options.repetitions
+         << ", best kernel " << kernelIsaName(detectKernelIsa()) << endl;
+
+    vector<BenchmarkResult> results;
+    for (int i = 0; i < VIEW_COUNT; i++) {
+        size_t first = results.size();
+        runKernelCases(options, VIEWS[i], results);
+        runRendererCases(options, VIEWS[i], results);
+        for (size_t k = first; k < results.size(); k++) {
+            printResult(results[k]);
+        }
+    }
+    size_t firstSink = results.size();
+    if (!runSinkCases(options, results, error)) {
+        cerr << "Benchmark: " << error << endl;
+        return 1;
+    }
+    for (size_t k = firstSink; k < results.size(); k++) {
+        printResult(results[k]);
+    }
+    runSierpinskiCase(options, results);
+    printResult(results.back());
+
+    if (!options.csvFile.empty() && !writeCsv(options.csvFile, results, error)) {
+        cerr << "Benchmark: " << error << endl;
+        return 1;
+    }
+    if (!options.jsonFile.empty() && !writeJson(options.jsonFile, options, results, error)) {
+        cerr << "Benchmark: " << error << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -105,6 +105,14 @@ unix:!macx {
     LIBS += -ldl
 }
 
+# std::thread support for the tile renderer (src/workpool.cpp)
+QMAKE_CXXFLAGS += -pthread
+QMAKE_LFLAGS += -pthread
+
+# double-double arithmetic (src/doubledouble.h) needs every multiplication
+# and addition rounded separately, without fused multiply-add
+QMAKE_CXXFLAGS += -ffp-contract=off
+
 # increase system stack size (helpful for recursive programs)
 win32 {
     QMAKE_LFLAGS += -Wl,--stack,536870912
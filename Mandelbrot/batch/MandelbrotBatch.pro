@@ -0,0 +1,73 @@
+# Headless batch renderer of the Mandelbrot set
+#
+# Builds command line program, which renders image straight to
+# PPM/BMP file. It uses render engine of the GUI program (../src),
+# without Stanford C++ library and its Java back end, so it runs
+# on machines without display and Java.
+#
+# Engine sources are listed one by one: ../src has GUI program too.
+#
+# @version 2026/10/17
+# - first version
+# - band renderer
+# - raster sinks
+# - zoom animation
+# - edge antialiasing
+# - tile profiles
+
+TEMPLATE = app
+TARGET = MandelbrotBatch
+CONFIG += console
+CONFIG -= qt app_bundle
+
+ENGINE = $$PWD/../src
+
+SOURCES += $$PWD/src/MandelbrotBatch.cpp
+SOURCES += $$ENGINE/antialias.cpp
+SOURCES += $$ENGINE/bandrenderer.cpp
+SOURCES += $$ENGINE/deepzoom.cpp
+SOURCES += $$ENGINE/highprecision.cpp
+SOURCES += $$ENGINE/imagewriter.cpp
+SOURCES += $$ENGINE/mandelbrotkernel.cpp
+SOURCES += $$ENGINE/palette.cpp
+SOURCES += $$ENGINE/tileprofile.cpp
+SOURCES += $$ENGINE/tilerenderer.cpp
+SOURCES += $$ENGINE/workpool.cpp
+SOURCES += $$ENGINE/zoomanimation.cpp
+
+HEADERS += $$ENGINE/antialias.h
+HEADERS += $$ENGINE/bandrenderer.h
+HEADERS += $$ENGINE/deepzoom.h
+HEADERS += $$ENGINE/doubledouble.h
+HEADERS += $$ENGINE/highprecision.h
+HEADERS += $$ENGINE/imagewriter.h
+HEADERS += $$ENGINE/mandelbrotkernel.h
+HEADERS += $$ENGINE/palette.h
+HEADERS += $$ENGINE/rastersink.h
+HEADERS += $$ENGINE/tileprofile.h
+HEADERS += $$ENGINE/tilerenderer.h
+HEADERS += $$ENGINE/workpool.h
+HEADERS += $$ENGINE/zoomanimation.h
+
+INCLUDEPATH += $$ENGINE/
+
+# the same compiler flags as the GUI program has (see ../Mandelbrot.pro)
+QMAKE_CXXFLAGS += -std=c++11
+QMAKE_CXXFLAGS_WARN_ON += -Wall
+QMAKE_CXXFLAGS_WARN_ON += -Wextra
+QMAKE_CXXFLAGS_WARN_ON += -Wno-sign-compare
+QMAKE_CXXFLAGS_WARN_ON += -Wno-unused-parameter
+QMAKE_CXXFLAGS += -pthread
+QMAKE_LFLAGS += -pthread
+QMAKE_CXXFLAGS += -ffp-contract=off
+
+# tile profiles cost two clock readings per tile; this line compiles them out
+# DEFINES += MANDELBROT_NO_TILE_PROFILE
+
+CONFIG(release, debug|release) {
+    QMAKE_CXXFLAGS += -O2
+}
+CONFIG(debug, debug|release) {
+    QMAKE_CXXFLAGS += -O0
+    QMAKE_CXXFLAGS += -g3
+}
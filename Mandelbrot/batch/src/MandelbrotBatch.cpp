@@ -0,0 +1,614 @@
+/********************************************************************************************
+* File: MandelbrotBatch.cpp
+* ----------------------
+* v.1 2026/10/17
+* - renders Mandelbrot set image straight to PPM/BMP file,
+*   without graphics back end,
+* - image is written band by band, so its size isn't limited by memory,
+* - file can be written through memory mapping,
+* - zoom animation from keyframes, frames reuse pixels of previous ones,
+* - adaptive iterations limit of tiles,
+* - edge antialiasing,
+* - Multibrot, Burning Ship and Julia formulas,
+* - tile profile as JSON file and heatmap image
+*
+* Command line renderer for batch jobs.
+********************************************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "antialias.h"
+#include "bandrenderer.h"
+#include "deepzoom.h"
+#include "highprecision.h"
+#include "imagewriter.h"
+#include "mandelbrotkernel.h"
+#include "palette.h"
+#include "tileprofile.h"
+#include "tilerenderer.h"
+#include "zoomanimation.h"
+
+using namespace std;
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const DEFAULT_WIDTH = 390;              /* Default image shows the area of the GUI start image */
+int const DEFAULT_HEIGHT = 360;
+int const DEFAULT_DEPTH = 500;
+char const DEFAULT_CENTRE_RE[] = "-0.7";
+char const DEFAULT_CENTRE_IM[] = "0.2";
+double const DEFAULT_STEP = 2.0 / 300;
+int const DEFAULT_FRAMES = 100;
+double const PERTURBATION_SPACING_LIMIT = 1e-28;    /* Smaller relative pixel spacing is
+                                                     * beyond double-double precision */
+int const HEATMAP_SCALE = 8;                /* Heatmap pixel stands for 8 x 8 image pixels */
+
+/* Type: BatchOptions
+ * ------------------
+ * Parameters of one run, from command line.  */
+struct BatchOptions {
+    int width;
+    int height;
+    int maxDepth;
+    int threadCount;
+    string centreRe;            /* Decimal strings: deep zooms need more digits than double */
+    string centreIm;
+    double step;
+    string precision;           /* "auto", "double", "double-double" or "perturbation" */
+    KernelOptions kernel;
+    RenderMode mode;
+    bool symmetry;
+    int bandRows;
+    int depthLimit;             /* Adaptive iterations limit, 0 - off */
+    int antialiasThreshold;     /* Depth difference of refined pixels, < 0 - off */
+    bool mapped;                /* Output file is mapped into memory */
+    string keyframes;           /* Keyframes file of animation, empty - single image */
+    int frames;
+    string profile;             /* JSON file of tile profiles, empty - none */
+    string heatmap;             /* Heatmap image of tile time, empty - none */
+    string output;
+};
+
+/*------------------------------------------------------------------------------------------//
+ * Implementation section.
+ * -----------------------
+ * Program uses the same render engine as the GUI program
+ * (Mandelbrot/src), but never starts Java back end: image is
+ * colorized by default palette and written to file.
+ * Frame centre is parsed in high precision, so frame edges keep
+ * double-double accuracy for deep zooms. Frames deeper than
+ * double-double precision are rendered by perturbation.
+ * Tile renderer writes image by bands (see BandRenderer): posters
+ * of any size need a few megabytes. Mapped file (--mapped) takes
+ * bands straight into its pages, without buffered writes.
+ * Perturbation renders the whole frame at once, its image must
+ * fit into memory.
+ * Animation frames are rendered by ZoomAnimator one after another
+ * and written as numbered files. Antialiasing isn't made for
+ * perturbation renders.
+ * Perturbation is made for Mandelbrot formula only: other formulas
+ * are rendered in double-double precision at any zoom.
+ * Tile profile (--profile, --heatmap) comes from the tile renderer,
+ * so perturbation renders and animations have none.
+ * -----------------------------------------------------------------------------------------*/
+
+/* Function: printUsage
+ * --------------------
+ * Prints command line parameters.  */
+void printUsage() {
+    cerr << "Usage: MandelbrotBatch [options] output.ppm|output.bmp" << endl
+         << "  --width N             image width, default " << DEFAULT_WIDTH << endl
+         << "  --height N            image height, default " << DEFAULT_HEIGHT << endl
+         << "  --re X                real value of the image centre, default "
+         << DEFAULT_CENTRE_RE << endl
+         << "  --im Y                imaginary value of the image centre, default "
+         << DEFAULT_CENTRE_IM << endl
+         << "  --step S              complex distance between pixels, default "
+         << DEFAULT_STEP << endl
+         << "  --depth N             limit for iterations quantity, default "
+         << DEFAULT_DEPTH << endl
+         << "  --threads N           render threads, default - one per core" << endl
+         << "  --kernel K            scalar, sse2 or avx2, default - the best for this CPU"
+         << endl
+         << "  --precision P         auto, double, double-double or perturbation,"
+         << " default auto" << endl
+         << "  --mode M              every (pixel) or mariani (-silver), default every" << endl
+         << "  --formula F           mandelbrot, multibrot3, multibrot4, burning-ship," << endl
+         << "                        julia or julia3, default mandelbrot" << endl
+         << "  --julia-re X          real value of Julia constant, default "
+         << KernelOptions().juliaRe << endl
+         << "  --julia-im Y          imaginary value of Julia constant, default "
+         << KernelOptions().juliaIm << endl
+         << "  --periodicity         stop interior orbits when they make a cycle," << endl
+         << "                        double precision only" << endl
+         << "  --adaptive-depth N    raise iterations limit of tiles at the set border" << endl
+         << "                        up to N (not for animation)" << endl
+         << "  --antialias N         supersample pixels whose depth differs from a" << endl
+         << "                        neighbour's by more than N, "
+         << EdgeAntialiaser::DEFAULT_THRESHOLD << " is a good start" << endl
+         << "  --no-symmetry         calculate rows mirrored about the real axis" << endl
+         << "  --band-rows N         rows rendered and written at once, default "
+         << BandRenderer::DEFAULT_BAND_ROWS << endl
+         << "  --mapped              write file through memory mapping" << endl
+         << "  --animate FILE        render zoom animation by keyframes of FILE, lines" << endl
+         << "                        \"time re im step\"; frames are written to" << endl
+         << "                        output_0000.ppm, output_0001.ppm, ..." << endl
+         << "  --frames N            frames of animation, default " << DEFAULT_FRAMES << endl
+         << "  --profile FILE        write time, iterations and pixels of tiles to JSON FILE"
+         << endl
+         << "  --heatmap FILE        write tile time per pixel as .ppm or .bmp image, one"
+         << endl
+         << "                        pixel for " << HEATMAP_SCALE << "x" << HEATMAP_SCALE
+         << " image pixels" << endl;
+}
+
+/* Function: parseNumber
+ * ---------------------
+ * Converts whole text to number, returns false if it isn't one.  */
+bool parseNumber(const string& text, double& value) {
+    char* end = NULL;
+    value = strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0' && std::isfinite(value);
+}
+
+bool parseNumber(const string& text, int& value) {
+    char* end = NULL;
+    long number = strtol(text.c_str(), &end, 10);
+    value = (int) number;
+    return !text.empty() && *end == '\0' && number == value;
+}
+
+/* Function: parseArguments
+ * ------------------------
+ * Fills options from command line, returns false and sets
+ * error for unknown or invalid parameter.  */
+bool parseArguments(int argc, char** argv, BatchOptions& options, string& error) {
+    options.width = DEFAULT_WIDTH;
+    options.height = DEFAULT_HEIGHT;
+    options.maxDepth = DEFAULT_DEPTH;
+    options.threadCount = 0;
+    options.centreRe = DEFAULT_CENTRE_RE;
+    options.centreIm = DEFAULT_CENTRE_IM;
+    options.step = DEFAULT_STEP;
+    options.precision = "auto";
+    options.mode = RENDER_EVERY_PIXEL;
+    options.symmetry = true;
+    options.bandRows = BandRenderer::DEFAULT_BAND_ROWS;
+    options.mapped = false;
+    options.depthLimit = 0;
+    options.antialiasThreshold = -1;
+    options.frames = DEFAULT_FRAMES;
+
+    for (int i = 1; i < argc; i++) {
+        string name = argv[i];
+        if (name == "--periodicity") {
+            options.kernel.periodicityCheck = true;
+            continue;
+        }
+        if (name == "--no-symmetry") {
+            options.symmetry = false;
+            continue;
+        }
+        if (name == "--mapped") {
+            options.mapped = true;
+            continue;
+        }
+        if (name.compare(0, 2, "--") != 0) {
+            if (!options.output.empty()) {
+                error = "only one output file is allowed";
+                return false;
+            }
+            options.output = name;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            error = "value expected after " + name;
+            return false;
+        }
+        string value = argv[++i];
+        bool valid = true;
+        if (name == "--width") {
+            valid = parseNumber(value, options.width) && options.width > 0;
+        } else if (name == "--height") {
+            valid = parseNumber(value, options.height) && options.height > 0;
+        } else if (name == "--depth") {
+            valid = parseNumber(value, options.maxDepth) && options.maxDepth > 0;
+        } else if (name == "--threads") {
+            valid = parseNumber(value, options.threadCount);
+        } else if (name == "--adaptive-depth") {
+            valid = parseNumber(value, options.depthLimit) && options.depthLimit > 0;
+        } else if (name == "--antialias") {
+            valid = parseNumber(value, options.antialiasThreshold)
+                    && options.antialiasThreshold >= 0;
+        } else if (name == "--band-rows") {
+            valid = parseNumber(value, options.bandRows) && options.bandRows > 0;
+        } else if (name == "--animate") {
+            options.keyframes = value;
+        } else if (name == "--profile") {
+            options.profile = value;
+        } else if (name == "--heatmap") {
+            ImageFormat format;
+            valid = imageFormatForFile(value, format);
+            options.heatmap = value;
+        } else if (name == "--frames") {
+            valid = parseNumber(value, options.frames) && options.frames > 0;
+        } else if (name == "--step") {
+            valid = parseNumber(value, options.step) && options.step > 0;
+        } else if (name == "--re") {
+            options.centreRe = value;
+        } else if (name == "--im") {
+            options.centreIm = value;
+        } else if (name == "--kernel") {
+            if (value == "scalar") {
+                options.kernel.isa = KERNEL_SCALAR;
+            } else if (value == "sse2") {
+                options.kernel.isa = KERNEL_SSE2;
+            } else if (value == "avx2") {
+                options.kernel.isa = KERNEL_AVX2;
+            } else {
+                valid = false;
+            }
+            if (valid && options.kernel.isa > detectKernelIsa()) {
+                error = "kernel " + value + " is not supported by this CPU";
+                return false;
+            }
+        } else if (name == "--formula") {
+            valid = formulaForName(value, options.kernel.formula);
+        } else if (name == "--julia-re") {
+            valid = parseNumber(value, options.kernel.juliaRe);
+        } else if (name == "--julia-im") {
+            valid = parseNumber(value, options.kernel.juliaIm);
+        } else if (name == "--precision") {
+            valid = (value == "auto" || value == "double" || value == "double-double"
+                     || value == "perturbation");
+            options.precision = value;
+        } else if (name == "--mode") {
+            if (value == "every") {
+                options.mode = RENDER_EVERY_PIXEL;
+            } else if (value == "mariani") {
+                options.mode = RENDER_MARIANI_SILVER;
+            } else {
+                valid = false;
+            }
+        } else {
+            error = "unknown option " + name;
+            return false;
+        }
+        if (!valid) {
+            error = "invalid value of " + name + ": " + value;
+            return false;
+        }
+    }
+    if (options.output.empty()) {
+        error = "output file expected";
+        return false;
+    }
+    if (options.precision == "perturbation" && options.kernel.formula != FORMULA_MANDELBROT) {
+        error = string("perturbation can't render formula ")
+                + formulaName(options.kernel.formula);
+        return false;
+    }
+    if (options.kernel.periodicityCheck
+            && (options.precision == "double-double" || options.precision == "perturbation")) {
+        error = "periodicity check is made with double precision only, not with "
+                + options.precision;
+        return false;
+    }
+    if (options.depthLimit > 0 && !options.keyframes.empty()) {
+        error = "adaptive depth is made for single images, not for animation";
+        return false;
+    }
+    bool profiled = !options.profile.empty() || !options.heatmap.empty();
+    if (profiled && (!options.keyframes.empty() || options.precision == "perturbation")) {
+        error = "tile profile is made for single images of tile renderer";
+        return false;
+    }
+    return true;
+}
+
+/* Function: makeFrameGeometry
+ * ---------------------------
+ * Returns frame with centre pixel (width / 2, height / 2) at the
+ * centre c-point, edges are calculated in high precision and
+ * kept as double-double values. Returns false if centre is not
+ * a number.  */
+bool makeFrameGeometry(const BatchOptions& options, FrameGeometry& frame, string& error) {
+    int bits = HighPrecision::bitsForStep(options.step);
+    HighPrecision centreRe = HighPrecision::parse(options.centreRe, bits, error);
+    if (!error.empty()) {
+        return false;
+    }
+    HighPrecision centreIm = HighPrecision::parse(options.centreIm, bits, error);
+    if (!error.empty()) {
+        return false;
+    }
+    HighPrecision left = centreRe - HighPrecision((options.width / 2) * options.step, bits);
+    HighPrecision top = centreIm - HighPrecision((options.height / 2) * options.step, bits);
+    frame.width = options.width;
+    frame.height = options.height;
+    frame.step = options.step;
+    frame.reLeft = left.toDouble();
+    frame.reLeftLow = (left - HighPrecision(frame.reLeft, bits)).toDouble();
+    frame.imTop = top.toDouble();
+    frame.imTopLow = (top - HighPrecision(frame.imTop, bits)).toDouble();
+    return true;
+}
+
+/* Function: configureRenderer
+ * ---------------------------
+ * Sets renderer options from command line.  */
+void configureRenderer(const BatchOptions& options, TileRenderer& renderer) {
+    renderer.setKernelOptions(options.kernel);
+    renderer.setRenderMode(options.mode);
+    renderer.setSymmetry(options.symmetry);
+    renderer.setAdaptiveDepth(options.depthLimit);
+    if (options.precision == "double") {
+        renderer.setPrecision(PRECISION_DOUBLE);
+    } else if (options.precision == "double-double") {
+        renderer.setPrecision(PRECISION_DOUBLE_DOUBLE);
+    }
+}
+
+/* Function: writeProfile
+ * ------------------------
+ * Writes render profile to files of --profile and --heatmap
+ * options. Returns false and sets error if file can't be written.  */
+bool writeProfile(const BatchOptions& options, const RenderProfile& profile, string& error) {
+    if (!options.profile.empty() && !writeRenderProfile(options.profile, profile, error)) {
+        return false;
+    }
+    ImageFormat format;
+    if (!options.heatmap.empty() && imageFormatForFile(options.heatmap, format)) {
+        int width = 0;
+        int height = 0;
+        vector<int> rgb;
+        makeHeatmap(profile, HEATMAP_SCALE, width, height, rgb);
+        if (!writeImage(options.heatmap, format, width, height, &rgb[0], error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Function: readKeyframes
+ * -----------------------
+ * Reads keyframes "time re im step", one per line, sorted by time;
+ * empty lines and lines from '#' are skipped. Returns false and
+ * sets error if file can't be read.  */
+bool readKeyframes(const string& filename, vector<ZoomKeyframe>& path, string& error) {
+    ifstream file(filename.c_str());
+    if (!file) {
+        error = "can't open keyframes file \"" + filename + "\"";
+        return false;
+    }
+    path.clear();
+    string line;
+    for (int lineNumber = 1; getline(file, line); lineNumber++) {
+        istringstream words(line);
+        string word[4];
+        if (!(words >> word[0]) || word[0][0] == '#') {
+            continue;
+        }
+        ZoomKeyframe key;
+        string rest;
+        bool valid = (words >> word[1] >> word[2] >> word[3]) && !(words >> rest)
+                && parseNumber(word[0], key.time) && parseNumber(word[1], key.centreRe)
+                && parseNumber(word[2], key.centreIm) && parseNumber(word[3], key.step)
+                && key.step > 0 && (path.empty() || key.time > path.back().time);
+        if (!valid) {
+            error = "invalid keyframe at line " + to_string(lineNumber) + " of \""
+                    + filename + "\"";
+            return false;
+        }
+        path.push_back(key);
+    }
+    if (path.empty()) {
+        error = "no keyframes in \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+/* Function: getFrameFilename
+ * --------------------------
+ * Returns name of animation frame: "zoom.ppm" -> "zoom_0012.ppm".  */
+string getFrameFilename(const string& output, int frameNumber) {
+    size_t dot = output.rfind('.');
+    char number[16];
+    snprintf(number, sizeof(number), "_%04d", frameNumber);
+    return output.substr(0, dot) + number + output.substr(dot);
+}
+
+/* Function: renderAnimation
+ * -------------------------
+ * Renders frames evenly spaced in time from the first keyframe
+ * to the last one, and reports part of pixels which every frame
+ * took from the previous one.  */
+bool renderAnimation(const BatchOptions& options, ImageFormat format, string& error) {
+    vector<ZoomKeyframe> path;
+    if (!readKeyframes(options.keyframes, path, error)) {
+        return false;
+    }
+    TileRenderer renderer(options.threadCount);
+    configureRenderer(options, renderer);
+    ZoomAnimator animator(renderer);
+    EdgeAntialiaser antialiaser(renderer, options.antialiasThreshold);
+    Palette palette = Palette::makeDefault(options.maxDepth);
+    vector<int> rgb((size_t) options.width * options.height);
+    double duration = path.back().time - path.front().time;
+    RenderStats total;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int i = 0; i < options.frames; i++) {
+        double time = path.front().time
+                + ((options.frames > 1) ? duration * i / (options.frames - 1) : 0);
+        FrameGeometry frame = getZoomFrame(path, time, options.width, options.height);
+        chrono::steady_clock::time_point frameStart = chrono::steady_clock::now();
+        const vector<int>& depths = animator.render(frame, options.maxDepth);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - frameStart)
+                .count();
+        if (options.antialiasThreshold >= 0) {
+            antialiaser.antialias(frame, options.maxDepth, &depths[0], palette, &rgb[0]);
+        } else {
+            palette.colorize(&depths[0], (int) depths.size(), &rgb[0]);
+        }
+        string filename = getFrameFilename(options.output, i);
+        if (!writeImage(filename, format, frame.width, frame.height, &rgb[0], error)) {
+            return false;
+        }
+        const RenderStats& stats = animator.getStats();
+        total.add(stats);
+        cout << filename << ": step " << frame.step
+             << ", reused " << (100.0 * stats.pixelsReused / stats.pixels) << "%, "
+             << seconds << " s" << endl;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << options.frames << " frames " << options.width << "x" << options.height
+         << ", depth " << options.maxDepth << ", threads " << renderer.getThreadCount() << endl;
+    cout << "Reused pixels: " << (100.0 * total.pixelsReused / total.pixels) << "%, "
+         << "time " << seconds << " s" << endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    string error;
+    if (!parseArguments(argc, argv, options, error)) {
+        cerr << "MandelbrotBatch: " << error << endl;
+        printUsage();
+        return 1;
+    }
+    ImageFormat format;
+    if (!imageFormatForFile(options.output, format)) {
+        cerr << "MandelbrotBatch: output file must be .ppm or .bmp" << endl;
+        return 1;
+    }
+    if (!options.keyframes.empty()) {
+        if (!renderAnimation(options, format, error)) {
+            cerr << "MandelbrotBatch: " << error << endl;
+            return 1;
+        }
+        return 0;
+    }
+    FrameGeometry frame;
+    if (!makeFrameGeometry(options, frame, error)) {
+        cerr << "MandelbrotBatch: " << error << endl;
+        return 1;
+    }
+
+    /* Perturbation is chosen automatically when double-double
+     * can't resolve neighbour pixels */
+    double magnitude = max(fabs(frame.reLeft), fabs(frame.imTop));
+    bool perturbation = (options.precision == "perturbation")
+            || (options.precision == "auto" && options.kernel.formula == FORMULA_MANDELBROT
+                && options.step < PERTURBATION_SPACING_LIMIT * max(1.0, magnitude));
+
+    /* Pixels inside of the set have depth depthLimit in adaptive depth mode */
+    bool adaptive = !perturbation && options.depthLimit > options.maxDepth;
+    Palette palette = Palette::makeDefault(adaptive ? options.depthLimit : options.maxDepth);
+    ImageStreamWriter writer;
+    MappedImageFile mappedFile;
+    RasterSink& sink = options.mapped ? (RasterSink&) mappedFile : (RasterSink&) writer;
+    bool opened = options.mapped
+            ? mappedFile.open(options.output, format, frame.width, frame.height, error)
+            : writer.open(options.output, format, frame.width, frame.height, error);
+    if (!opened) {
+        cerr << "MandelbrotBatch: " << error << endl;
+        return 1;
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    long long iterations = 0;
+    long long tilesDeepened = 0;
+    long long pixelsRefined = 0;
+    string usedPrecision;
+    int threadCount = 0;
+    RenderProfile profile;
+    if (perturbation) {
+        DeepZoomFrame deepFrame;
+        deepFrame.width = frame.width;
+        deepFrame.height = frame.height;
+        deepFrame.centreRe = options.centreRe;
+        deepFrame.centreIm = options.centreIm;
+        deepFrame.step = options.step;
+        PerturbationRenderer renderer(options.threadCount);
+        vector<int> depths((size_t) frame.width * frame.height);
+        if (!renderer.render(deepFrame, options.maxDepth, &depths[0], error)) {
+            cerr << "MandelbrotBatch: " << error << endl;
+            return 1;
+        }
+        vector<int> rgb(depths.size());
+        palette.colorize(&depths[0], (int) depths.size(), &rgb[0]);
+        if (!sink.writeRect(0, 0, frame.width, frame.height, &rgb[0], error)) {
+            cerr << "MandelbrotBatch: " << error << endl;
+            return 1;
+        }
+        iterations = renderer.getStats().iterations;
+        usedPrecision = "perturbation";
+        threadCount = renderer.getThreadCount();
+    } else {
+        TileRenderer renderer(options.threadCount);
+        configureRenderer(options, renderer);
+        BandRenderer bands(renderer, options.bandRows);
+        EdgeAntialiaser antialiaser(renderer, options.antialiasThreshold);
+        if (options.antialiasThreshold >= 0) {
+            bands.setAntialiaser(&antialiaser);
+        }
+        if (!bands.render(frame, options.maxDepth, palette, sink, error)) {
+            cerr << "MandelbrotBatch: " << error << endl;
+            return 1;
+        }
+        iterations = bands.getStats().iterations;
+        tilesDeepened = bands.getStats().tilesDeepened;
+        pixelsRefined = bands.getStats().pixelsRefined;
+        usedPrecision = kernelPrecisionName(renderer.getPrecision());
+        threadCount = renderer.getThreadCount();
+        profile = bands.getProfile();
+    }
+    bool closed = options.mapped ? mappedFile.close(error) : writer.close(error);
+    if (!closed) {
+        cerr << "MandelbrotBatch: " << error << endl;
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double pixels = (double) frame.width * frame.height;
+    cout << frame.width << "x" << frame.height << ", depth " << options.maxDepth
+         << ", " << (options.mapped ? "mapped" : "buffered") << " file"
+         << ", formula " << formulaName(options.kernel.formula)
+         << ", kernel " << kernelIsaName(options.kernel.isa)
+         << ", precision " << usedPrecision
+         << ", threads " << threadCount << endl;
+    cout << "Render and write time: " << seconds << " s, "
+         << (pixels / seconds / 1e6) << " Mpixel/s, "
+         << (iterations / seconds / 1e6) << " Miteration/s" << endl;
+    if (adaptive) {
+        cout << "Tiles with raised iterations limit: " << tilesDeepened << endl;
+    }
+    if (options.kernel.periodicityCheck && usedPrecision != "double") {
+        cerr << "MandelbrotBatch: periodicity check is not made with precision "
+             << usedPrecision << endl;
+    }
+    if (options.antialiasThreshold >= 0 && !perturbation) {
+        cout << "Pixels refined by antialiasing: " << (100.0 * pixelsRefined / pixels) << "%"
+             << endl;
+    }
+    if (!options.profile.empty() || !options.heatmap.empty()) {
+        if (perturbation) {
+            cerr << "MandelbrotBatch: perturbation render has no tile profile" << endl;
+        } else if (!writeProfile(options, profile, error)) {
+            cerr << "MandelbrotBatch: " << error << endl;
+            return 1;
+        } else {
+            cout << "Tiles: " << profile.tiles.size() << ", waited for writing "
+                 << profile.writeWaitSeconds << " s" << endl;
+        }
+    }
+    cout << "Written: " << options.output << endl;
+    return 0;
+}
@@ -4,6 +4,14 @@
  * This file implements the platform interface by passing commands to
  * a Java back end that manages the display.
  * 
+ * @version 2026/10/17
+ * - added bulk pixel upload for GBufferedImage (setPixels)
+ * - bulk pixel upload uses temporary file with unique name, made by exclusive create
+ * - flush hooks (e.g. of deferred GBufferedImage changes) run before repaint, pause,
+ *   event waits and at exit
+ * - Linux/Mac commands to the back-end are buffered and written by few syscalls
+ * - Linux/Mac replies of the back-end are read by blocks, not by single chars
+ * - added binary framed protocol, used when the back-end offers it (Linux/Mac)
  * @version 2014/11/14
  * - added method to set unit test runtime in MS
  * @version 2014/11/05
@@ -38,6 +46,7 @@
 #  include <sys/types.h>
 #  include <sys/stat.h>
 #  include <sys/resource.h>
+#  include <sys/uio.h>
 #  include <dirent.h>
 #  include <errno.h>
 #  include <pwd.h>
@@ -81,6 +90,60 @@ static int pout;
 // related: similar constant in Java back-end stanford.spl.SplPipeDecoder.java
 static const size_t PIPE_MAX_COMMAND_LENGTH = 4096;
 
+// counters of commands put to the back-end, which took 2 write calls each
+// before buffering, and of write calls made for them (Linux/Mac only)
+static long long pipeCommandsPut = 0;
+static long long pipeWriteCalls = 0;
+
+// bulk pixel upload: pipe bytes of one GBufferedImage.fillRegion command per
+// rectangle of one color, e.g. GBufferedImage.fillRegion("0x55d0c8a3e2f0", 120, 45, 7, 1, 16711680)
+static const int GBUFFEREDIMAGE_RUN_COMMAND_BYTES = 70;
+// and of its binary frame: length, opcode, id and 5 ints
+static const int GBUFFEREDIMAGE_RUN_FRAME_BYTES = 4 + 2 + 8 + 5 * 4;
+
+// rectangle of pixels of one color, sent by one fillRegion command
+struct ColorRect {
+    int x;
+    int y;
+    int width;
+    int height;
+    int rgb;
+};
+
+// binary protocol: its name as the back-end lists it after its version and
+// the opcodes of its frames (see beginFrame and getResult); a back-end which
+// speaks it must use the same numbers
+static const std::string PIPE_BINARY_PROTOCOL = "binary/1";
+enum PipeOpcode {
+    // both directions
+    OP_TEXT = 1,                        // string: a line of the text protocol
+    // back-end to C++
+    OP_RESULT = 2,                      // string
+    OP_ACK = 3,                         // -
+    OP_ERROR = 4,                       // string
+    OP_EVENT = 5,                       // see getFrameEvent
+    // C++ to back-end
+    OP_GOBJECT_SET_LOCATION = 16,       // id, x, y
+    OP_GOBJECT_SET_COLOR = 17,          // id, color
+    OP_GOBJECT_SET_FILLED = 18,         // id, flag
+    OP_GOBJECT_SET_FILL_COLOR = 19,     // id, color
+    OP_GOBJECT_DELETE = 20,             // id
+    OP_GCOMPOUND_ADD = 21,              // compound id, id
+    OP_GWINDOW_DRAW = 22,               // window id, id
+    OP_GLINE_CREATE = 32,               // id, x1, y1, x2, y2
+    OP_GRECT_CREATE = 33,               // id, width, height
+    OP_GOVAL_CREATE = 34,               // id, width, height
+    OP_GBUFFEREDIMAGE_FILL = 48,        // id, rgb
+    OP_GBUFFEREDIMAGE_FILL_REGION = 49, // id, x, y, width, height, rgb
+    OP_GBUFFEREDIMAGE_SET_RGB = 50      // id, x, y, rgb
+};
+
+// true once both sides have switched to binary frames (Linux/Mac only);
+// the query of the back-end version sent by initPipe is answered by the
+// first reply read, see getResult
+static bool binaryProtocol = false;
+static bool protocolQueryPending = false;
+
 static std::string getLineConsole();
 static void putConsole(const std::string& str, bool isStderr = false);
 static void endLineConsole(bool isStderr = false);
@@ -264,6 +327,20 @@ static pid_t javaBackEndPid;
 static void initPipe();
 static void putPipe(std::string line);
 static void putPipeLongString(std::string line);
+static void flushPipe();
+static void runFlushHooks();
+static void beginFrame(PipeOpcode opcode);
+static void appendFrameInt(unsigned long long value, int size);
+static void appendFrameId(const void* id);
+static void appendFrameDouble(double value);
+static void appendFrameString(const std::string& value);
+static void putFrame();
+static void getFrame(std::string& frame);
+static void findColorRects(const Grid<int>& pixels, int x, int y, int width, int height,
+                           std::vector<ColorRect>& rects);
+static FILE* createTempFile(const std::string& directory, const std::string& prefix,
+                            std::string& filename);
+static bool writeBitmapFile(FILE* output, const Grid<int>& pixels);
 static std::string getPipe();
 static std::string getResult(bool consumeAcks = false, const std::string& caller = "");
 static void getStatus();
@@ -273,6 +350,7 @@ static GEvent parseKeyEvent(TokenScanner& scanner, EventType type);
 static GEvent parseTimerEvent(TokenScanner& scanner, EventType type);
 static GEvent parseWindowEvent(TokenScanner& scanner, EventType type);
 static GEvent parseActionEvent(TokenScanner& scanner, EventType type);
+static GEvent getFrameEvent(const std::string& frame, size_t& pos);
 
 /* Implementation of the Platform class */
 
@@ -689,9 +767,11 @@ void Platform::gwindow_clear(const GWindow& gw) {
 }
 
 void Platform::gwindow_repaint(const GWindow& gw) {
+    runFlushHooks();
     std::ostringstream os;
     os << "GWindow.repaint(\"" << gw.gwd << "\")";
     putPipe(os.str());
+    flushPipe();
 }
 
 void Platform::gwindow_setSize(const GWindow& gw, int width, int height) {
@@ -765,6 +845,7 @@ double Platform::gwindow_getScreenWidth() {
 }
 
 void Platform::gtimer_pause(double milliseconds) {
+    runFlushHooks();
     std::ostringstream os;
     os << "GTimer.pause(" << milliseconds << ")";
     putPipe(os.str());
@@ -837,12 +918,25 @@ int Platform::url_download(std::string url, std::string filename) {
 }
 
 void Platform::gobject_delete(GObject* gobj) {
+    if (binaryProtocol) {
+        beginFrame(OP_GOBJECT_DELETE);
+        appendFrameId(gobj);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GObject.delete(\"" << gobj << "\")";
     putPipe(os.str());
 }
 
 void Platform::gcompound_add(GObject *compound, GObject* gobj) {
+    if (binaryProtocol) {
+        beginFrame(OP_GCOMPOUND_ADD);
+        appendFrameId(compound);
+        appendFrameId(gobj);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GCompound.add(\"" << compound << "\", \"" << gobj << "\")";
     putPipe(os.str());
@@ -964,6 +1058,13 @@ void Platform::gwindow_setVisible(const GWindow& gw, bool flag) {
 }
 
 void Platform::gobject_setColor(GObject* gobj, std::string color) {
+    if (binaryProtocol) {
+        beginFrame(OP_GOBJECT_SET_COLOR);
+        appendFrameId(gobj);
+        appendFrameString(color);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GObject.setColor(\"" << gobj << "\", \"" << color << "\")";
     putPipe(os.str());
@@ -1012,6 +1113,14 @@ void Platform::gobject_setLineWidth(GObject* gobj, double lineWidth) {
 }
 
 void Platform::gobject_setLocation(GObject* gobj, double x, double y) {
+    if (x >= 0 && y >= 0 && binaryProtocol) {
+        beginFrame(OP_GOBJECT_SET_LOCATION);
+        appendFrameId(gobj);
+        appendFrameDouble(x);
+        appendFrameDouble(y);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     if (x >= 0 && y >= 0) {
         os << "GObject.setLocation(\"" << gobj << "\", " << x << ", " << y << ")";
@@ -1078,6 +1187,13 @@ void Platform::garc_setFrameRectangle(GObject* gobj, double x, double y,
 }
 
 void Platform::gwindow_draw(const GWindow& gw, const GObject* gobj) {
+    if (binaryProtocol) {
+        beginFrame(OP_GWINDOW_DRAW);
+        appendFrameId(gw.gwd);
+        appendFrameId(gobj);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GWindow.draw(\"" << gw.gwd << "\", \"" << gobj << "\")";
     putPipe(os.str());
@@ -1090,18 +1206,40 @@ void Platform::gwindow_drawInBackground(const GWindow& gw, const GObject* gobj)
 }
 
 void Platform::gobject_setFilled(GObject* gobj, bool flag) {
+    if (binaryProtocol) {
+        beginFrame(OP_GOBJECT_SET_FILLED);
+        appendFrameId(gobj);
+        appendFrameInt(flag, 1);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GObject.setFilled(\"" << gobj << "\", " << std::boolalpha << flag << ")";
     putPipe(os.str());
 }
 
 void Platform::gobject_setFillColor(GObject* gobj, std::string color) {
+    if (binaryProtocol) {
+        beginFrame(OP_GOBJECT_SET_FILL_COLOR);
+        appendFrameId(gobj);
+        appendFrameString(color);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GObject.setFillColor(\"" << gobj << "\", \"" << color << "\")";
     putPipe(os.str());
 }
 
 void Platform::grect_constructor(GObject* gobj, double width, double height) {
+    if (binaryProtocol) {
+        beginFrame(OP_GRECT_CREATE);
+        appendFrameId(gobj);
+        appendFrameDouble(width);
+        appendFrameDouble(height);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GRect.create(\"" << gobj << "\", " << width << ", "
        << height << ")";
@@ -1142,6 +1280,16 @@ void Platform::glabel_constructor(GObject* gobj, std::string label) {
 
 void Platform::gline_constructor(GObject* gobj, double x1, double y1,
                            double x2, double y2) {
+    if (binaryProtocol) {
+        beginFrame(OP_GLINE_CREATE);
+        appendFrameId(gobj);
+        appendFrameDouble(x1);
+        appendFrameDouble(y1);
+        appendFrameDouble(x2);
+        appendFrameDouble(y2);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GLine.create(\"" << gobj << "\", " << x1 << ", " << y1
        << ", " << x2 << ", " << y2 << ")";
@@ -1200,12 +1348,30 @@ void Platform::gbufferedimage_constructor(GObject* gobj, double x, double y,
 }
 
 void Platform::gbufferedimage_fill(GObject* gobj, int rgb) {
+    if (binaryProtocol) {
+        beginFrame(OP_GBUFFEREDIMAGE_FILL);
+        appendFrameId(gobj);
+        appendFrameInt(rgb, 4);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GBufferedImage.fill(\"" << gobj << "\", " << rgb << ")";
     putPipe(os.str());
 }
 
 void Platform::gbufferedimage_fillRegion(GObject* gobj, double x, double y, double width, double height, int rgb) {
+    if (binaryProtocol) {
+        beginFrame(OP_GBUFFEREDIMAGE_FILL_REGION);
+        appendFrameId(gobj);
+        appendFrameInt((int) x, 4);
+        appendFrameInt((int) y, 4);
+        appendFrameInt((int) width, 4);
+        appendFrameInt((int) height, 4);
+        appendFrameInt(rgb, 4);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GBufferedImage.fillRegion(\"" << gobj << "\", " << (int) x << ", "
        << (int) y << ", " << (int) width << ", " << (int) height << ", " << rgb << ")";   // BUGBUG: was missing ", " token
@@ -1237,8 +1403,58 @@ std::string Platform::gbufferedimage_save(const GObject* const gobj, const std::
     return getResult();
 }
 
+/*
+ * The back-end has no command for many pixels at once, so a range is sent in
+ * one of two ways, whichever moves fewer bytes:
+ * - one fillRegion command per rectangle of one color in the range (see
+ *   findColorRects), so cells of a coarse progressive pass take one command
+ *   each, as when they were painted directly;
+ * - the whole image (pixels holds all of it) written to a temporary 24-bit BMP
+ *   file, which the back-end reads by its load command in one go.  The file
+ *   holds the whole image even for a small range, and load replies with the
+ *   whole image too, as base64 of one "#rrggbb" line per pixel.
+ * If load fails, the range is sent as rectangles.
+ */
+void Platform::gbufferedimage_setPixels(GObject* gobj, const Grid<int>& pixels,
+                                        int x, int y, int width, int height) {
+    std::vector<ColorRect> rects;
+    findColorRects(pixels, x, y, width, height, rects);
+    long long imagePixels = (long long) pixels.numRows() * pixels.numCols();
+    long long bitmapBytes = 54 + (3LL * pixels.numCols() + 3) / 4 * 4 * pixels.numRows();
+    long long replyBytes = (8 * imagePixels + 2) / 3 * 4;
+    long long runBytes = binaryProtocol ? GBUFFEREDIMAGE_RUN_FRAME_BYTES
+                                        : GBUFFEREDIMAGE_RUN_COMMAND_BYTES;
+    if ((long long) rects.size() * runBytes > bitmapBytes + replyBytes) {
+        std::string filename;
+        FILE* output = createTempFile(filelib_getTempDirectory(), "spl_gbufferedimage_",
+                                      filename);
+        if (output) {
+            bool loaded = writeBitmapFile(output, pixels)
+                    && !startsWith(gbufferedimage_load(gobj, filename), "error:");
+            std::remove(filename.c_str());
+            if (loaded) {
+                return;
+            }
+        }
+    }
+    for (size_t i = 0; i < rects.size(); i++) {
+        const ColorRect& rect = rects[i];
+        gbufferedimage_fillRegion(gobj, rect.x, rect.y, rect.width, rect.height, rect.rgb);
+    }
+    flushPipe();
+}
+
 void Platform::gbufferedimage_setRGB(GObject* gobj, double x, double y,
                                      int rgb) {
+    if (binaryProtocol) {
+        beginFrame(OP_GBUFFEREDIMAGE_SET_RGB);
+        appendFrameId(gobj);
+        appendFrameInt((int) x, 4);
+        appendFrameInt((int) y, 4);
+        appendFrameInt(rgb, 4);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GBufferedImage.setRGB(\"" << gobj << "\", " << (int) x << ", "
        << (int) y << ", " << rgb << ")";
@@ -1271,6 +1487,14 @@ void Platform::gpolygon_addVertex(GObject* gobj, double x, double y) {
 }
 
 void Platform::goval_constructor(GObject* gobj, double width, double height) {
+    if (binaryProtocol) {
+        beginFrame(OP_GOVAL_CREATE);
+        appendFrameId(gobj);
+        appendFrameDouble(width);
+        appendFrameDouble(height);
+        putFrame();
+        return;
+    }
     std::ostringstream os;
     os << "GOval.create(\"" << gobj << "\", " << width << ", "
        << height << ")";
@@ -1528,6 +1752,7 @@ GDimension Platform::glabel_getSize(const GObject* gobj) {
 }
 
 GEvent Platform::gevent_getNextEvent(int mask) {
+    runFlushHooks();
     if (eventQueue.isEmpty()) {
         putPipe("GEvent.getNextEvent(" + integerToString(mask) + ")");
         getResult();
@@ -1537,6 +1762,7 @@ GEvent Platform::gevent_getNextEvent(int mask) {
 }
 
 GEvent Platform::gevent_waitForEvent(int mask) {
+    runFlushHooks();
     while (eventQueue.isEmpty()) {
         putPipe("GEvent.waitForEvent(" + integerToString(mask) + ")");
 
@@ -1680,6 +1906,196 @@ static void putPipeLongString(std::string line) {
     putPipe("LongCommand.end()");
 }
 
+/*
+ * Splits the range of pixels into rectangles of one color: every horizontal
+ * run of one color goes down as long as the rows below have the very same run
+ * (same columns, same color, different neighbours).
+ */
+static void findColorRects(const Grid<int>& pixels, int x, int y, int width, int height,
+                           std::vector<ColorRect>& rects) {
+    // row below the last rectangle sent for each column of the range
+    std::vector<int> coveredBottom(width, y);
+    for (int r = y; r < y + height; r++) {
+        int runStart = x;
+        for (int c = x + 1; c <= x + width; c++) {
+            if (c < x + width && pixels[r][c] == pixels[r][runStart]) {
+                continue;
+            }
+            if (coveredBottom[runStart - x] <= r) {
+                ColorRect rect = { runStart, r, c - runStart, 1, pixels[r][runStart] };
+                while (r + rect.height < y + height) {
+                    int below = r + rect.height;
+                    bool sameRun = (runStart == x || pixels[below][runStart - 1] != rect.rgb)
+                            && (c == x + width || pixels[below][c] != rect.rgb);
+                    for (int k = runStart; sameRun && k < c; k++) {
+                        sameRun = pixels[below][k] == rect.rgb;
+                    }
+                    if (!sameRun) {
+                        break;
+                    }
+                    rect.height++;
+                }
+                for (int k = runStart; k < c; k++) {
+                    coveredBottom[k - x] = r + rect.height;
+                }
+                rects.push_back(rect);
+            }
+            runStart = c;
+        }
+    }
+}
+
+/*
+ * Creates a new file in directory, with a name no other file has, and opens it
+ * for binary writing.  The name starts with prefix (on Windows, with its first
+ * 3 chars).  Returns NULL if file can't be created; otherwise sets filename.
+ */
+static FILE* createTempFile(const std::string& directory, const std::string& prefix,
+                            std::string& filename) {
+#ifdef _WIN32
+    char path[MAX_PATH];
+    if (GetTempFileNameA(directory.c_str(), prefix.c_str(), 0, path) == 0) {
+        return NULL;
+    }
+    filename = path;
+    FILE* output = fopen(path, "wb");
+#else
+    std::string pattern = directory + "/" + prefix + "XXXXXX.bmp";
+    std::vector<char> path(pattern.begin(), pattern.end());
+    path.push_back('\0');
+    int fd = mkstemps(&path[0], 4);   // O_CREAT | O_EXCL, mode 0600
+    if (fd < 0) {
+        return NULL;
+    }
+    filename = &path[0];
+    FILE* output = fdopen(fd, "wb");
+    if (!output) {
+        close(fd);
+    }
+#endif
+    if (!output) {
+        std::remove(filename.c_str());
+    }
+    return output;
+}
+
+/*
+ * Writes pixels as uncompressed 24-bit BMP file: rows go from the bottom up,
+ * each padded to a multiple of 4 bytes.  Closes output.  Returns false if
+ * file can't be written.
+ */
+static bool writeBitmapFile(FILE* output, const Grid<int>& pixels) {
+    int width = pixels.numCols();
+    int height = pixels.numRows();
+    int rowSize = (3 * width + 3) / 4 * 4;
+    unsigned int fields[] = {
+        (unsigned int) (54 + rowSize * height), 0, 54,    // file size, reserved, pixels offset
+        40, (unsigned int) width, (unsigned int) height,  // info header size, image size
+        1 | (24 << 16), 0, (unsigned int) (rowSize * height), 2835, 2835, 0, 0
+    };
+    std::string data = "BM";
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            data += (char) ((fields[i] >> shift) & 0xff);
+        }
+    }
+    std::string row(rowSize, '\0');
+    for (int r = height - 1; r >= 0; r--) {
+        for (int c = 0; c < width; c++) {
+            int rgb = pixels[r][c];
+            row[3 * c] = (char) (rgb & 0xff);
+            row[3 * c + 1] = (char) ((rgb >> 8) & 0xff);
+            row[3 * c + 2] = (char) ((rgb >> 16) & 0xff);
+        }
+        data += row;
+    }
+    bool written = fwrite(data.data(), 1, data.size(), output) == data.size();
+    return (fclose(output) == 0) && written;
+}
+
+/*
+ * Binary protocol frames, in both directions: 4-byte payload length, then the
+ * payload, which is a 2-byte opcode and its arguments.  All numbers are
+ * little-endian; ids are the 8-byte pointer values the text protocol prints,
+ * int arguments take 4 bytes, coordinates are 8-byte IEEE doubles and
+ * strings are a 4-byte length followed by their bytes.
+ * A command is built in pipeFrame by beginFrame and appendFrame* calls and
+ * passed on by putFrame; getFrame and the frame* functions read replies.
+ */
+static std::string pipeFrame;
+
+static void beginFrame(PipeOpcode opcode) {
+    pipeFrame.assign(4, '\0');   // length, set by putFrame
+    appendFrameInt(opcode, 2);
+}
+
+static void appendFrameInt(unsigned long long value, int size) {
+    for (int i = 0; i < size; i++) {
+        pipeFrame += (char) ((value >> (8 * i)) & 0xff);
+    }
+}
+
+static void appendFrameId(const void* id) {
+    appendFrameInt((unsigned long long) (size_t) id, 8);
+}
+
+static void appendFrameDouble(double value) {
+    unsigned long long bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendFrameInt(bits, 8);
+}
+
+static void appendFrameString(const std::string& value) {
+    appendFrameInt(value.length(), 4);
+    pipeFrame += value;
+}
+
+static void setFrameLength() {
+    size_t length = pipeFrame.length() - 4;
+    for (int i = 0; i < 4; i++) {
+        pipeFrame[i] = (char) ((length >> (8 * i)) & 0xff);
+    }
+}
+
+static unsigned long long frameInt(const std::string& frame, size_t& pos, int size) {
+    if (pos + size > frame.length()) {
+        error("Platform: truncated frame from Java back-end");
+    }
+    unsigned long long value = 0;
+    for (int i = 0; i < size; i++) {
+        value |= (unsigned long long) (unsigned char) frame[pos + i] << (8 * i);
+    }
+    pos += size;
+    return value;
+}
+
+static int frameSignedInt(const std::string& frame, size_t& pos) {
+    return (int) (unsigned int) frameInt(frame, pos, 4);
+}
+
+static double frameDouble(const std::string& frame, size_t& pos) {
+    unsigned long long bits = frameInt(frame, pos, 8);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static std::string frameString(const std::string& frame, size_t& pos) {
+    size_t length = frameInt(frame, pos, 4);
+    if (pos + length > frame.length()) {
+        error("Platform: truncated frame from Java back-end");
+    }
+    pos += length;
+    return frame.substr(pos - length, length);
+}
+
+// formats a frame id as the text protocol prints it, e.g. for windowTable
+static std::string frameId(const std::string& frame, size_t& pos) {
+    std::ostringstream os;
+    os << (void*) (size_t) frameInt(frame, pos, 8);
+    return os.str();
+}
+
 #ifdef _WIN32
 
 /* Windows implementation of interface to Java back end */
@@ -1797,6 +2213,9 @@ static void initPipe() {
         CloseHandle(pInfo.hProcess);
         CloseHandle(pInfo.hThread);
     }
+
+    // changes still held by flush hooks when the program ends go out then
+    atexit(runFlushHooks);
 }
 
 static void putPipe(std::string line) {
@@ -1814,6 +2233,19 @@ static void putPipe(std::string line) {
     WinCheck(FlushFileBuffers(wrToJBE));
 }
 
+static void flushPipe() {
+    // Windows commands are not buffered
+}
+
+static void putFrame() {
+    // Windows doesn't ask the back-end for the binary protocol
+    error("Platform::putFrame: binary protocol is not supported on Windows");
+}
+
+static void getFrame(std::string& /*frame*/) {
+    error("Platform::getFrame: binary protocol is not supported on Windows");
+}
+
 static std::string getPipe() {
     std::string line = "";
     DWORD nch;
@@ -1846,15 +2278,16 @@ static std::string getPipe() {
 
 /* Linux/Mac implementation of interface to Java back end */
 
-static bool LinCheck(ssize_t result) {
-    if (result == EPIPE) {
-        // fputs("Error from Java back-end subprocess.\n", stderr);
-        // throw InterruptedIOException();
-        return false;
-    } else {
-        return true;
-    }
-}
+// commands to the back-end waiting to be written, see putPipe
+static const size_t PIPE_OUT_BUFFER_SIZE = 65536;
+static std::string pipeOutBuffer;
+
+// replies of the back-end read ahead and not yet returned, see getPipe;
+// unread bytes are pipeInBuffer[pipeInStart] ... pipeInBuffer[pipeInEnd - 1]
+static const size_t PIPE_IN_BUFFER_SIZE = 65536;
+static char pipeInBuffer[PIPE_IN_BUFFER_SIZE];
+static size_t pipeInStart = 0;
+static size_t pipeInEnd = 0;
 
 static void scanOptions() {
     char *home = getenv("HOME");
@@ -1960,6 +2393,8 @@ void startupMainDontRunMain(int /*argc*/, char** argv) {
     setConsoleProperties();
 }
 
+static void flushPipeAtExit();
+
 static void sigPipeHandler(int /*signum*/) {
     // use stderr directly rather than cerr because graphical console may be unreachable
     fputs("***\n", stderr);
@@ -2052,10 +2487,70 @@ static void initPipe() {
         
         // stop the pipe from generating a SIGPIPE when JBE is closed
         signal(SIGPIPE, sigPipeHandler);
+
+        // changes held by flush hooks and commands still buffered
+        // when the program ends go out then
+        atexit(flushPipeAtExit);
+
+        // the back-end lists the protocols it speaks after its version;
+        // the reply is awaited by the first getResult, not here, so the
+        // program runs on while the back-end starts up
+        putPipe("StanfordCppLib.getJbeVersion()");
+        protocolQueryPending = true;
+    }
+}
+
+/*
+ * Commands are collected in pipeOutBuffer and written when it fills up,
+ * before any read from the back-end (getPipe), when output must be seen
+ * at once (console text, repaint, image upload) and at exit.
+ * A command which doesn't fit goes out together with the buffer by one
+ * writev call, without being copied.
+ */
+static void writePipe(struct iovec* parts, int count) {
+    while (count > 0) {
+        ssize_t written = writev(pout, parts, count);
+        pipeWriteCalls++;
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;   // back-end is gone
+        }
+        while (count > 0 && (size_t) written >= parts->iov_len) {
+            written -= parts->iov_len;
+            parts++;
+            count--;
+        }
+        if (count > 0) {
+            parts->iov_base = (char*) parts->iov_base + written;
+            parts->iov_len -= written;
+        }
     }
 }
 
+static void flushPipe() {
+    if (pipeOutBuffer.empty()) return;
+    struct iovec part;
+    part.iov_base = &pipeOutBuffer[0];
+    part.iov_len = pipeOutBuffer.length();
+    writePipe(&part, 1);
+    pipeOutBuffer.clear();
+}
+
+static void flushPipeAtExit() {
+    // back-end may be closed already; don't report it from exit
+    signal(SIGPIPE, SIG_IGN);
+    runFlushHooks();
+    flushPipe();
+}
+
 static void putPipe(std::string line) {
+    if (binaryProtocol) {
+        // a frame is not limited in length, so no LongCommand chunks
+        beginFrame(OP_TEXT);
+        appendFrameString(line);
+        putFrame();
+        return;
+    }
     if (line.length() > PIPE_MAX_COMMAND_LENGTH) {
         putPipeLongString(line);
         return;
@@ -2063,28 +2558,112 @@ static void putPipe(std::string line) {
 #ifdef PIPE_DEBUG
     fprintf(stderr, "putPipe(\"%s\")\n", line.c_str());  fflush(stderr);
 #endif
-    LinCheck(write(pout, line.c_str(), line.length()));
-    LinCheck(write(pout, "\n", 1));
+    pipeCommandsPut++;
+    if (pipeOutBuffer.length() + line.length() + 1 > PIPE_OUT_BUFFER_SIZE) {
+        struct iovec parts[3];
+        parts[0].iov_base = &pipeOutBuffer[0];
+        parts[0].iov_len = pipeOutBuffer.length();
+        parts[1].iov_base = &line[0];
+        parts[1].iov_len = line.length();
+        parts[2].iov_base = (void*) "\n";
+        parts[2].iov_len = 1;
+        writePipe(parts, 3);
+        pipeOutBuffer.clear();
+    } else {
+        pipeOutBuffer += line;
+        pipeOutBuffer += '\n';
+    }
     if (tracePipe) logfile << "-> " << line << std::endl;
 }
 
-static std::string getPipe() {
+static void putFrame() {
+    setFrameLength();
 #ifdef PIPE_DEBUG
-    fprintf(stderr, "getPipe(): waiting ...\n");  fflush(stderr);
+    fprintf(stderr, "putFrame(): %d bytes\n", (int) pipeFrame.length());  fflush(stderr);
 #endif
-    std::string line = "";
-    int charsRead = 0;
-    int charsReadMax = PIPE_MAX_COMMAND_LENGTH + 100;
-    while (charsRead < charsReadMax) {
-        char ch;
-        ssize_t result = read(pin, &ch, 1);
+    pipeCommandsPut++;
+    if (pipeOutBuffer.length() + pipeFrame.length() > PIPE_OUT_BUFFER_SIZE) {
+        struct iovec parts[2];
+        parts[0].iov_base = &pipeOutBuffer[0];
+        parts[0].iov_len = pipeOutBuffer.length();
+        parts[1].iov_base = &pipeFrame[0];
+        parts[1].iov_len = pipeFrame.length();
+        writePipe(parts, 2);
+        pipeOutBuffer.clear();
+    } else {
+        pipeOutBuffer += pipeFrame;
+    }
+    if (tracePipe) logfile << "-> frame of " << pipeFrame.length() << " bytes" << std::endl;
+}
+
+// reads more replies of the back-end into the empty pipeInBuffer
+static void readPipe() {
+    while (true) {
+        ssize_t result = read(pin, pipeInBuffer, PIPE_IN_BUFFER_SIZE);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
         if (result <= 0) {
             throw InterruptedIOException();
             // break;   // failed to read from subprocess
         }
-        if (ch == '\n') break;
-        line += ch;
-        charsRead++;
+        pipeInStart = 0;
+        pipeInEnd = result;
+        return;
+    }
+}
+
+// reads count bytes of replies into bytes
+static void getPipeBytes(std::string& bytes, size_t count) {
+    bytes.clear();
+    while (bytes.length() < count) {
+        if (pipeInStart == pipeInEnd) {
+            readPipe();
+        }
+        size_t chunk = std::min(pipeInEnd - pipeInStart, count - bytes.length());
+        bytes.append(pipeInBuffer + pipeInStart, chunk);
+        pipeInStart += chunk;
+    }
+}
+
+static void getFrame(std::string& frame) {
+    // back-end answers only commands it has got
+    flushPipe();
+    getPipeBytes(frame, 4);
+    size_t pos = 0;
+    size_t length = frameInt(frame, pos, 4);
+    getPipeBytes(frame, length);
+#ifdef PIPE_DEBUG
+    fprintf(stderr, "getFrame(): %d bytes\n", (int) length);  fflush(stderr);
+#endif
+    if (tracePipe) logfile << "<- frame of " << length << " bytes" << std::endl;
+}
+
+static std::string getPipe() {
+    // back-end answers only commands it has got
+    flushPipe();
+#ifdef PIPE_DEBUG
+    fprintf(stderr, "getPipe(): waiting ...\n");  fflush(stderr);
+#endif
+    // a line is copied from pipeInBuffer into the result string at once;
+    // bytes after its end stay in the buffer for the next call
+    std::string line = "";
+    size_t charsReadMax = PIPE_MAX_COMMAND_LENGTH + 100;
+    while (true) {
+        const char* start = pipeInBuffer + pipeInStart;
+        size_t count = std::min(pipeInEnd - pipeInStart, charsReadMax - line.length());
+        const char* end = (const char*) memchr(start, '\n', count);
+        if (end != NULL) {
+            line.append(start, end - start);
+            pipeInStart += end - start + 1;
+            break;
+        }
+        line.append(start, count);
+        pipeInStart += count;
+        if (line.length() >= charsReadMax) {
+            break;
+        }
+        readPipe();
     }
 #ifdef PIPE_DEBUG
     fprintf(stderr, "getPipe(): \"%s\"\n", line.c_str());  fflush(stderr);
@@ -2095,12 +2674,69 @@ static std::string getPipe() {
 
 #endif
 
+/*
+ * Switches both sides to binary frames if the back-end version reply lists
+ * the binary protocol ("2026/10/17 binary/1").  Older back-ends reply with
+ * their version alone and are never sent a command they don't know.
+ */
+static void negotiateProtocol(const std::string& jbeVersion) {
+    if ((" " + jbeVersion + " ").find(" " + PIPE_BINARY_PROTOCOL + " ") == std::string::npos) {
+        return;
+    }
+    std::ostringstream out;
+    out << "StanfordCppLib.setProtocol(";
+    writeQuotedString(out, PIPE_BINARY_PROTOCOL);
+    out << ")";
+    putPipe(out.str());
+    // back-end sends frames after its "ok" and reads them after this command
+    binaryProtocol = getResult() == "ok";
+}
+
 static std::string getResult(bool consumeAcks, const std::string& caller) {
+    if (protocolQueryPending) {
+        // replies come in order, so the version queried by initPipe is first
+        protocolQueryPending = false;
+        std::string jbeVersion = getResult();
+        std::string result = getResult(consumeAcks, caller);
+        negotiateProtocol(jbeVersion);
+        return result;
+    }
+    static std::string frame;
     while (true) {
+        std::string line;
+        if (binaryProtocol) {
+            getFrame(frame);
+            size_t pos = 0;
+            int opcode = frameInt(frame, pos, 2);
+            if (opcode == OP_RESULT) {
+                return frameString(frame, pos);
+            } else if (opcode == OP_ACK) {
+                if (!consumeAcks) {
+                    return "___jbe___ack___";
+                }
+                continue;
+            } else if (opcode == OP_ERROR) {
+                std::ostringstream out;
+                out << "ERROR emitted from Stanford Java back-end process:"
+                    << std::endl << frameString(frame, pos);
+                error(out.str());
+            } else if (opcode == OP_EVENT) {
+                eventQueue.enqueue(getFrameEvent(frame, pos));
+                continue;
+            } else if (opcode == OP_TEXT) {
+                // anything else comes as a line of the text protocol, e.g. rare
+                // events and stack traces; results are never sent as result_long
+                line = frameString(frame, pos);
+            } else {
+                error("Platform: unknown frame opcode " + integerToString(opcode)
+                      + " from Java back-end");
+            }
+        } else {
 #ifdef PIPE_DEBUG
-        fprintf(stderr, "getResult(): calling getPipe() ...\n");  fflush(stderr);
+            fprintf(stderr, "getResult(): calling getPipe() ...\n");  fflush(stderr);
 #endif
-        std::string line = getPipe();
+            line = getPipe();
+        }
         bool isResult = startsWith(line, "result:");
         bool isResultLong = startsWith(line, "result_long:");
         bool isEvent  = startsWith(line, "event:");
@@ -2129,14 +2765,14 @@ static std::string getResult(bool consumeAcks, const std::string& caller) {
             }
         } else if (isResultLong) {
             // read a 'long' result (more than ~4096 chars; sent across multiple lines)
-            std::ostringstream os;
-            // os << line.substr(17);   // don't add first line "result_long:begin"
+            std::string result;
+            // result += line.substr(17);   // don't add first line "result_long:begin"
             std::string nextLine = getPipe();
             while (nextLine != "result_long:end") {
-                os << nextLine;
+                result += nextLine;
                 nextLine = getPipe();
             }
-            return os.str();
+            return result;
         } else if (isEvent) {
             GEvent event = parseEvent(line.substr(6));
             eventQueue.enqueue(event);
@@ -2292,6 +2928,45 @@ static GEvent parseWindowEvent(TokenScanner& scanner, EventType type) {
     return e;
 }
 
+/*
+ * Compact event of an OP_EVENT frame: 2-byte EventType, source id, time,
+ * then modifiers, x, y for mouse events and modifiers, key char, key code
+ * (4-byte ints) for key events.  Timer events and window resizes need no more.
+ * Events with side effects here (window and console closing) and action
+ * events come as text lines.
+ */
+static GEvent getFrameEvent(const std::string& frame, size_t& pos) {
+    EventType type = (EventType) frameInt(frame, pos, 2);
+    std::string id = frameId(frame, pos);
+    double time = frameDouble(frame, pos);
+    if ((type & MOUSE_EVENT) != 0) {
+        int modifiers = frameSignedInt(frame, pos);
+        double x = frameDouble(frame, pos);
+        double y = frameDouble(frame, pos);
+        GMouseEvent e(type, GWindow(windowTable.get(id)), x, y);
+        e.setEventTime(time);
+        e.setModifiers(modifiers);
+        return e;
+    } else if ((type & KEY_EVENT) != 0) {
+        int modifiers = frameSignedInt(frame, pos);
+        int keyChar = frameSignedInt(frame, pos);
+        int keyCode = frameSignedInt(frame, pos);
+        GKeyEvent e(type, GWindow(windowTable.get(id)), char(keyChar), keyCode);
+        e.setEventTime(time);
+        e.setModifiers(modifiers);
+        return e;
+    } else if (type == TIMER_TICKED) {
+        GTimerEvent e(type, GTimer(timerTable.get(id)));
+        e.setEventTime(time);
+        return e;
+    } else if (type == WINDOW_RESIZED) {
+        GWindowEvent e(type, GWindow(windowTable.get(id)));
+        e.setEventTime(time);
+        return e;
+    }
+    return GEvent();
+}
+
 static GEvent parseActionEvent(TokenScanner& scanner, EventType type) {
     scanner.verifyToken("(");
     std::string id = scanner.getStringValue(scanner.nextToken());
@@ -2307,6 +2982,31 @@ static GEvent parseActionEvent(TokenScanner& scanner, EventType type) {
 
 /* Console code */
 
+// functions registered by cpplib_addFlushHook; the list is never destroyed,
+// because hooks run from atexit, after static objects may be gone
+static std::vector<Platform::FlushHook>& getFlushHooks() {
+    static std::vector<Platform::FlushHook>* flushHooks = new std::vector<Platform::FlushHook>();
+    return *flushHooks;
+}
+
+static void runFlushHooks() {
+    std::vector<Platform::FlushHook>& hooks = getFlushHooks();
+    for (size_t i = 0; i < hooks.size(); i++) {
+        hooks[i]();
+    }
+}
+
+void Platform::cpplib_addFlushHook(FlushHook hook) {
+    std::vector<FlushHook>& hooks = getFlushHooks();
+    if (std::find(hooks.begin(), hooks.end(), hook) == hooks.end()) {
+        hooks.push_back(hook);
+    }
+}
+
+long long Platform::cpplib_getPipeWritesSaved() {
+    return 2 * pipeCommandsPut - pipeWriteCalls;
+}
+
 void Platform::cpplib_setCppLibraryVersion() {
     std::ostringstream out;
     out << "StanfordCppLib.setCppVersion(";
@@ -2325,7 +3025,8 @@ std::string Platform::cpplib_getJavaBackEndVersion() {
     if (endsWith(result, '"')) {
         result = result.substr(0, result.length() - 1);
     }
-    return result;
+    // protocols listed after the version, see negotiateProtocol
+    return result.substr(0, result.find(' '));
 }
 
 void Platform::jbeconsole_clear() {
@@ -2498,6 +3199,7 @@ static void putConsole(const std::string& str, bool isStderr) {
     
     os << "," << std::boolalpha << isStderr << ")";
     putPipe(os.str());
+    flushPipe();
     echoConsole(str, isStderr);
 }
 
@@ -2512,6 +3214,7 @@ static void echoConsole(const std::string& str, bool isStderr) {
 
 static void endLineConsole(bool isStderr) {
     putPipe("JBEConsole.println()");
+    flushPipe();
     echoConsole("\n", isStderr);
 }
 
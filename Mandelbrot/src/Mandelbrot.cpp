@@ -1,6 +1,30 @@
 ﻿/********************************************************************************************
 * File: Mandelbrot.cpp
 * ----------------------
+* v.3 2026/10/17
+* - recursive equation is replaced by iterative vector kernel
+*   (see mandelbrotkernel.h),
+* - image is calculated by tiles on all cores (see tilerenderer.h),
+* - main cardioide and period-2 bulb are painted without iterations,
+* - optional periodicity check for other interior points,
+* - optional Mariani-Silver mode: uniform rectangles are filled at once,
+* - optional deep zoom by perturbation of one high precision orbit
+*   (see deepzoom.h),
+* - kernel precision (double or double-double) follows zoom depth,
+* - progressive render: coarse image is shown at once, then refined,
+* - viewport object instead of fixed image position, arrow keys pan
+*   the image, and only newly exposed strips are calculated,
+* - iterations quantities are kept apart from colors: image is
+*   colorized by palette lookup table, made at compile time,
+* - rows which mirror other rows about the real axis are copied,
+* - optional adaptive iterations limit: tiles near the set border
+*   get more iterations than MAX_DEPTH,
+* - optional antialiasing: pixels at edges of depth areas are supersampled,
+* - iteration formula can be changed: Multibrot, Burning Ship and Julia sets,
+* - full resolution image is sent to the graphics back end at once
+*   (see GBufferedImage::setPixels), not pixel by pixel,
+* - image is in deferred mode: regions of coarse passes are painted
+*   locally and sent to the back end together
 * v.2 2015/12/24
 * - fields are renamed,
 * - code is reformatted
@@ -10,8 +34,17 @@
 
 #include <iostream>
 #include "console.h"
+#include "gevents.h"
 #include <stdlib.h>
+#include <vector>
 #include "gbufferedimage.h"
+#include "antialias.h"
+#include "deepzoom.h"
+#include "mandelbrotkernel.h"
+#include "tilerenderer.h"
+#include "framecache.h"
+#include "palette.h"
+#include "viewport.h"
 
 using namespace std;
 
@@ -21,13 +54,33 @@ using namespace std;
 GBufferedImage* img;
 double const RADIUS = 300;              /* Represents radius value "2" on the complex area  */
 int const MAX_DEPTH = 500;              /* Limit for iterations quantity  */
+bool const PERIODICITY_CHECK = false;   /* Stop interior orbits when they make a cycle */
+bool const MARIANI_SILVER = false;      /* Fill rectangles with uniform border at once */
+bool const PROGRESSIVE = true;          /* Show 1/16 and 1/4 resolution images first */
+bool const ADAPTIVE_DEPTH = false;      /* Raise iterations limit of tiles at the set border */
+int const ADAPTIVE_DEPTH_LIMIT = 16 * MAX_DEPTH;    /* Highest limit of adaptive tiles */
+bool const ANTIALIAS = false;           /* Supersample pixels at edges of depth areas */
+FractalFormula const FORMULA = FORMULA_MANDELBROT;  /* Iteration formula of the tile image */
+
+bool const DEEP_ZOOM = false;           /* Draw DEEP_ZOOM_CENTRE area instead of whole set */
+int const DEEP_ZOOM_DEPTH = 5000;       /* Deep areas need much more iterations */
+char const DEEP_ZOOM_CENTRE_RE[] = "-1.74006238257933990522084416706583";
+char const DEEP_ZOOM_CENTRE_IM[] = "0.02817533977921104899241152114433";
+double const DEEP_ZOOM_STEP = 1e-28;    /* Complex distance between neighbour pixels */
 
 double const GW_WIDTH = 1.3 * RADIUS;   /* Main image parameters, koeficients make          */
 double const GW_HEIGHT = 1.2 * RADIUS;  /* cardioide position being closer to window centre */
 
-int const COLORS_RANGE = 255;           /* Possible range of colors values */
+int const PAN_PIXELS = GW_WIDTH / 20;   /* Arrow key moves image by 5% of its width */
+
 int const WHITE = 0xffffff;
 
+/* Colors of iterations quantities 0...MAX_DEPTH, table is made by compiler;
+ * adaptive depth needs colors up to ADAPTIVE_DEPTH_LIMIT */
+Palette const PALETTE = ADAPTIVE_DEPTH
+        ? Palette::makeDefault(ADAPTIVE_DEPTH_LIMIT)
+        : Palette(DefaultPalette<MAX_DEPTH>::table.colors, MAX_DEPTH);
+
 /*------------------------------------------------------------------------------------------//
  * Implementation section.
  * -----------------------
@@ -41,142 +94,239 @@ int const WHITE = 0xffffff;
  * - window left edge is "-2" of real complex value.
  * User can enter RADIUS value in declarations part
  * of code to change sizes of program image.
+ * Arrow keys move the image over the complex area.
  * -----------------------------------------------------------------------------------------*/
 
-/* Function: calculateMandelbrotEquation
- * --------------------------------------
- * Returns iterations quantity for current c-point(params a, b),
- * due to previous Z-value (params zR, zI).
+/* Function: getStartViewport
+ * ---------------------------
+ * Returns position of program image on the complex
+ * area at start, due to implementation describtion
+ * above: the real value axis (b = 0) is on the middle
+ * of the image height.  */
+Viewport getStartViewport() {
+    int width = (int) GW_WIDTH;
+    int height = (int) GW_HEIGHT;
+    double step = 2 / RADIUS;   /* RADIUS pixels represent "2" on complex area */
+    /* Left edge - "-2" real complex value,
+     * top edge - "-1" imaginary complex value */
+    return Viewport(width, height, -2 + (width / 2) * step, -1 + (height / 2) * step, step);
+}
+
+/* Function: colorizeImage
+ * ------------------------
+ * Fills rgb with colors of pixels with iterations quantities
+ * depths. Coloring is separate from iterations: other palette
+ * needs no recalculation of the image.
  *
- * @param a, b       Current complex area c-point: c = a + jb
- * @param zR, zI     Previous complex Z-value parameters: Z = zR + jzI
- * @param iter       Counter of iterations have been made yet  */
-int calculateMandelbrotEquation(double a,
-                double b,
-                double zR,
-                double zI,
-                int iter) {
-    /* Main Z-value rised to power:
-     * zLenght = Z^2 = zR^2 + jzI^2 */
-    double zLength;
-    /* Euaquations for zLength */
-    double buf = (zR * zR) - (zI * zI);
-    zI = (2 * zR * zI) + b;
-    zR = buf + a;
-    zLength = (zR * zR) + (zI * zI);
-    iter++;
-
-    /* Implementation notes
-     * --------------------------------------------------------------------
-     * In this program  we make such Mandelbrot apreciation:
-     *   if (Z^2 < 4) for every iteration - this c-point belongs
-     *   to Mandelbrot set. If we limit iterations quantity by MAX_DEPTH,
-     *   and if for every iteration this apreciation will be true
-     *   we can finish sequences for this c-point. This c-point is from
-     *   Mandelbrot set then - it will be black on the picture.
-     *
-     *   Else, if we don't meet confition - so we find external point
-     *   for Mandelbrot set, and we could choose color for it due
-     *   to depth iterations value.
-     * -------------------------------------------------------------------- */
-
-    /* Main apreciation process */
-    if ((zLength < 4) && (iter < MAX_DEPTH)) {
-        return calculateMandelbrotEquation(a, b, zR, zI, iter);//Continue calculations
-    }else{
-        return iter;                        //Stop calculations
-    }
+ * @param depths        Iterations quantities of the frame pixels
+ * @param palette       Colors of iterations quantities
+ * @param rgb           Output colors of the frame pixels  */
+void colorizeImage(const vector<int>& depths, const Palette& palette, vector<int>& rgb) {
+    rgb.resize(depths.size());
+    palette.colorize(&depths[0], (int) depths.size(), &rgb[0]);
 }
 
-/* Function: getIterationDepth
- * ---------------------------
- * Returns iterations quantity for current pixel.
- * Position of Current pixel is modified into
- * complex area scale position. In this complex area we made
- * evaluations, to what set this point belongs. If depth value
- * rises  MAX_DEPTH - so it's internal point of
- * Manelbrot set, and it will be black on image. If we obtain
- * smaller value then MAX_DEPTH - determine that this is external point
- * and we can paint it in some other color.
+/* Function: antialiasImage
+ * --------------------------
+ * Colorizes frame like colorizeImage, but pixels at edges of
+ * depth areas get average color of 4 x 4 samples, and reports
+ * part of such pixels.
  *
- * @param col, row       Current image position  */
-int getIterationDepth(double col, double row) {
-    /* Implementation notes
-     * --------------------------------------------------------------------
-     * The user radius represents R = 2 radius on the
-     * complex area. The main cardioide of the Madelbrot
-     * set is inserted in this circle. In this program
-     * window image position is taken due to radius value,
-     * so the image size depends of the radius and
-     * always represents the same part of the complex circle.
-     * This circle positioned in such way:
-     *  - At the left side of the program image is the
-     *    "-2" real complex value - left edge of the
-     *    Mandelbrot set.
-     *  - Top edge - is "-1" complex imaginary value
-     *  - Image bottom edge - is "1" complex imaginary value
-     *  - Image right side - is > "1" complex real value
-     *  - The real value axis (b = 0) is on the middle of the
-     *    image height.
-     * So, modification of image position is strict, and
-     * requires significant corrections in demand.
-     * --------------------------------------------------------------------*/
-
-    /* Modifies image pixel position into
-     * complex area position (c = a + jb) due
-     * to implementation describtion above   */
-    double a = col * (2 / RADIUS) - 2; /* a - real complex value */
-    double b = row * (2 / RADIUS) - 1; /* b - imaginary complex value */
-
-    /* Implementation notes
-     * --------------------------------------------------------------------
-     * The main apreciation parameter of program is Z value,
-     * which forms sequences like this:
-     * Z0 = 0
-     * Znext = Zpreviuos^2 + c
-     * ...
-     *
-     * The main Mandelbrot idea is "|Z| < R" for every iterations depth,
-     * where R could be taken as "2" for simplification.
-     *
-     * We try to discover if this c-point satisfy this condition
-     * for any iteration. If it's true - it will be black point on the image.
-     * --------------------------------------------------------------------*/
-
-    /* Apreciation starts from Z0 = z0R + jz0I = 0.             */
-    double z0R = 0;  /* Represents real value for complex Z0       */
-    double z0I = 0;  /* Represents imaginary value for complex Z0  */
-    int iter = 0;    /* Start value for iterations counter */
-
-    /* Makes sequence of Z-value calculations for current c-point
-     * to find out iterations quantity  */
-    int depth = calculateMandelbrotEquation(a, b, z0R, z0I, iter);
-
-    return depth;
+ * @param antialiaser   Antialiaser of the frame
+ * @param frame         Frame geometry
+ * @param depths        Iterations quantities of the frame pixels
+ * @param rgb           Output colors of the frame pixels  */
+void antialiasImage(EdgeAntialiaser& antialiaser,
+                    const FrameGeometry& frame,
+                    const vector<int>& depths,
+                    vector<int>& rgb) {
+    rgb.resize(depths.size());
+    antialiaser.antialias(frame, PALETTE.getMaxDepth(), &depths[0], PALETTE, &rgb[0]);
+    const RenderStats& stats = antialiaser.getStats();
+    cout << "Pixels refined by antialiasing: "
+         << (100.0 * stats.pixelsRefined / stats.pixels) << "%" << endl;
+}
+
+/* Function: paintCells
+ * ---------------------
+ * Paints image after progressive render pass: every cell of
+ * cellSize x cellSize pixels has the same color. Neighbour cells
+ * of one color in a row are painted as one region; full resolution
+ * image is uploaded as a whole. Image is in deferred mode, so
+ * regions of the pass are sent to the back end by one flush, which
+ * finds the same cell-high rectangles again: it sends no more
+ * fillRegion commands than painting them directly would.
+ *
+ * @param rgb           Colors of the frame pixels
+ * @param frame         Frame size
+ * @param cellSize      Cell size of the pass, 1 - every pixel  */
+void paintCells(const vector<int>& rgb, const FrameGeometry& frame, int cellSize) {
+    if (cellSize == 1) {
+        img->setPixels(0, 0, frame.width, frame.height, &rgb[0]);
+        img->flush();
+        return;
+    }
+    for (int row = 0; row < frame.height; row += cellSize) {
+        int height = min(cellSize, frame.height - row);
+        const int* line = &rgb[row * frame.width];
+        int runStart = 0;
+        int runColor = line[0];
+        for (int col = cellSize; col < frame.width; col += cellSize) {
+            int color = line[col];
+            if (color != runColor) {
+                img->fillRegion(runStart, row, col - runStart, height, runColor);
+                runStart = col;
+                runColor = color;
+            }
+        }
+        img->fillRegion(runStart, row, frame.width - runStart, height, runColor);
+    }
+    img->flush();
+}
+
+/* Function: printRenderStats
+ * --------------------------
+ * Reports pixels which were painted without iterations.  */
+void printRenderStats(const TileRenderer& renderer) {
+    const RenderStats& stats = renderer.getStats();
+    cout << "Cardioide/bulb pixels skipped: " << stats.interiorSkipped
+         << " of " << stats.pixels << endl;
+    cout << "Pixels mirrored about the real axis: " << stats.pixelsMirrored << endl;
+    cout << "Iterations made: " << stats.iterations
+         << " (" << kernelPrecisionName(renderer.getPrecision()) << " precision)" << endl;
+    if (ADAPTIVE_DEPTH) {
+        const vector<TileDepth>& tiles = renderer.getTileDepths();
+        int deepest = MAX_DEPTH;
+        for (size_t i = 0; i < tiles.size(); i++) {
+            deepest = max(deepest, tiles[i].maxDepth);
+        }
+        cout << "Tiles with raised iterations limit: " << stats.tilesDeepened
+             << " of " << tiles.size() << ", the highest limit: " << deepest << endl;
+    }
+    if (MARIANI_SILVER) {
+        cout << "Pixels filled without calculations: "
+             << (100.0 * stats.pixelsFilled / stats.pixels) << "%" << endl;
+    }
 }
 
 int main() {
     GWindow gw;
     gw.setSize(GW_WIDTH, GW_HEIGHT);
     img = new GBufferedImage(GW_WIDTH, GW_HEIGHT, WHITE);
+    img->setDeferred(true);
     gw.add(img, 0, 0);
-    /* For every image pixel:
-     * - modifies it into complex area scale;
-     * - appreciates, if it satisfy Mandelbrot set condition
-     * - choses color of pixel due to Mandelbrot set condition */
-    for (int row = 0; row < GW_HEIGHT; row++) {
-        for (int col = 0; col < GW_WIDTH; col++) {
-            /* Determines main Mandelbrot condition (described above)
-             * for this pixel */
-            int currentDepth = getIterationDepth(col, row);
-            /* Set color for pixel:
-             * - if currentDepth = MAX_DEPTH - it's black pixel
-             * - if currentDepth < MAX_DEPTH - set apropriate color */
-            int color = COLORS_RANGE * (MAX_DEPTH - currentDepth) / MAX_DEPTH;
-            int pixelColor = color * color * color;
-            img->setRGB(col, row, pixelColor);
+
+    Viewport view = getStartViewport();
+    FrameGeometry frame = view.getFrameGeometry();
+    vector<int> depths(frame.width * frame.height);
+    vector<int> rgb;
+
+    /* Deep zoom area is far beyond double precision of
+     * Viewport, it's calculated by perturbation */
+    if (DEEP_ZOOM) {
+        DeepZoomFrame deepFrame;
+        deepFrame.width = frame.width;
+        deepFrame.height = frame.height;
+        deepFrame.centreRe = DEEP_ZOOM_CENTRE_RE;
+        deepFrame.centreIm = DEEP_ZOOM_CENTRE_IM;
+        deepFrame.step = DEEP_ZOOM_STEP;
+        PerturbationRenderer deepRenderer;
+        string error;
+        if (!deepRenderer.render(deepFrame, DEEP_ZOOM_DEPTH, &depths[0], error)) {
+            cout << "Deep zoom error: " << error << endl;
+            return 0;
+        }
+        const DeepZoomStats& deepStats = deepRenderer.getStats();
+        cout << "Reference orbit: " << deepStats.referenceLength << " iterations, "
+             << deepStats.precisionBits << " bits" << endl;
+        cout << "Glitched pixels: " << deepStats.glitchedPixels
+             << ", rebases: " << deepStats.rebases << endl;
+        colorizeImage(depths, Palette::makeDefault(DEEP_ZOOM_DEPTH), rgb);
+        paintCells(rgb, frame, 1);
+        return 0;
+    }
+
+    /* Determines main Mandelbrot condition |Z| < 2 for every
+     * iteration of Znext = Zprevious^2 + c, Z0 = 0 (see
+     * mandelbrotkernel.h) for every image pixel: image is split
+     * into tiles, which are calculated on all processor cores */
+    TileRenderer renderer;
+    KernelOptions kernelOptions;
+    kernelOptions.periodicityCheck = PERIODICITY_CHECK;
+    kernelOptions.formula = FORMULA;
+    renderer.setKernelOptions(kernelOptions);
+    renderer.setRenderMode(MARIANI_SILVER ? RENDER_MARIANI_SILVER : RENDER_EVERY_PIXEL);
+    renderer.setAdaptiveDepth(ADAPTIVE_DEPTH ? ADAPTIVE_DEPTH_LIMIT : 0);
+    EdgeAntialiaser antialiaser(renderer);
+
+    /* Every pass is painted as soon as it's done: the first
+     * one takes 1/16 of the full render time. Antialiasing
+     * follows the last pass */
+    if (PROGRESSIVE && !MARIANI_SILVER) {
+        renderer.renderProgressive(frame, MAX_DEPTH, &depths[0], [&](int cellSize) {
+            colorizeImage(depths, PALETTE, rgb);
+            paintCells(rgb, frame, cellSize);
+        });
+        printRenderStats(renderer);
+        if (ANTIALIAS) {
+            antialiasImage(antialiaser, frame, depths, rgb);
+            paintCells(rgb, frame, 1);
         }
+    } else {
+        renderer.render(frame, MAX_DEPTH, &depths[0]);
+        printRenderStats(renderer);
+        if (ANTIALIAS) {
+            antialiasImage(antialiaser, frame, depths, rgb);
+            paintCells(rgb, frame, 1);
+        } else {
+            colorizeImage(depths, PALETTE, rgb);
+            paintCells(rgb, frame, 1);
+        }
+    }
+
+    /* Arrow keys move the image: pixels which stay visible
+     * are reused, only exposed strips are calculated */
+    FrameCache cache(renderer);
+    cache.setFrame(frame, MAX_DEPTH, depths);
+    gw.requestFocus();
+    while (true) {
+        GEvent event = waitForEvent(KEY_EVENT | WINDOW_EVENT);
+        if (event.getEventType() == WINDOW_CLOSED) {
+            break;
+        }
+        if (event.getEventType() != KEY_PRESSED) {
+            continue;
+        }
+        int dx = 0;
+        int dy = 0;
+        switch (GKeyEvent(event).getKeyCode()) {
+        case LEFT_ARROW_KEY:
+            dx = -PAN_PIXELS;
+            break;
+        case RIGHT_ARROW_KEY:
+            dx = PAN_PIXELS;
+            break;
+        case UP_ARROW_KEY:
+            dy = -PAN_PIXELS;
+            break;
+        case DOWN_ARROW_KEY:
+            dy = PAN_PIXELS;
+            break;
+        default:
+            continue;
+        }
+        view.pan(dx, dy);
+        depths = cache.render(view, MAX_DEPTH);
+        const RenderStats& panStats = cache.getStats();
+        cout << "Pixels calculated after pan: "
+             << (panStats.pixels - panStats.pixelsMirrored - panStats.pixelsReused)
+             << " of " << depths.size() << ", reused: " << panStats.pixelsReused << endl;
+        if (ANTIALIAS) {
+            antialiasImage(antialiaser, view.getFrameGeometry(), depths, rgb);
+        } else {
+            colorizeImage(depths, PALETTE, rgb);
+        }
+        paintCells(rgb, frame, 1);
     }
     return 0;
 }
-
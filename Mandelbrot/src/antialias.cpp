@@ -0,0 +1,125 @@
+/********************************************************************************************
+* File: antialias.cpp
+* ----------------------
+* v.1 2026/10/17
+* - supersampling of pixels at edges of depth areas
+*
+* Implementation of the antialias.h interface.
+********************************************************************************************/
+
+#include "antialias.h"
+#include <algorithm>
+#include <cstdlib>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const BAND_ROWS = 8;    /* Pixel rows which are supersampled together */
+
+EdgeAntialiaser::EdgeAntialiaser(TileRenderer& renderer, int threshold)
+        : renderer(renderer),
+          threshold(threshold) {
+}
+
+const RenderStats& EdgeAntialiaser::getStats() const {
+    return stats;
+}
+
+/* Implementation notes: antialias
+ * --------------------------------------------------------------------
+ * Samples of a band of rows form a frame with step / S (S is
+ * SAMPLES_PER_SIDE): sample (i, j) of pixel (col, row) is sample
+ * (S * col + i, S * row + j) and has c-point shifted by
+ * (i / S - 1/2, j / S - 1/2) pixel steps. Origin of the samples frame
+ * is S * origin - S / 2, so sample (S / 2, S / 2) has exactly the
+ * c-point of the pixel and takes its depth. Samples of pixels which
+ * aren't refined are marked as known, and renderUnknown calculates
+ * the rest on all cores.
+ * --------------------------------------------------------------------*/
+void EdgeAntialiaser::antialias(const FrameGeometry& frame,
+                                int maxDepth,
+                                const int* depths,
+                                const Palette& palette,
+                                int* rgb,
+                                int contextAbove,
+                                int contextBelow) {
+    int const S = SAMPLES_PER_SIDE;
+    stats = RenderStats();
+    int lastRow = frame.height - contextBelow;
+    stats.pixels = (long long) frame.width * std::max(0, lastRow - contextAbove);
+    palette.colorize(depths, frame.width * frame.height, rgb);
+
+    for (int firstRow = contextAbove; firstRow < lastRow; firstRow += BAND_ROWS) {
+        int rows = std::min(BAND_ROWS, lastRow - firstRow);
+        refined.assign(frame.width * rows, 0);
+        int refinedCount = 0;
+        for (int row = firstRow; row < firstRow + rows; row++) {
+            const int* line = depths + row * frame.width;
+            for (int col = 0; col < frame.width; col++) {
+                int depth = line[col];
+                bool edge = (col > 0 && std::abs(line[col - 1] - depth) > threshold)
+                        || (col + 1 < frame.width && std::abs(line[col + 1] - depth) > threshold)
+                        || (row > 0 && std::abs(line[col - frame.width] - depth) > threshold)
+                        || (row + 1 < frame.height
+                            && std::abs(line[col + frame.width] - depth) > threshold);
+                if (edge) {
+                    refined[(row - firstRow) * frame.width + col] = 1;
+                    refinedCount++;
+                }
+            }
+        }
+        if (refinedCount == 0) {
+            continue;
+        }
+        stats.pixelsRefined += refinedCount;
+
+        FrameGeometry band = frame;
+        band.width = S * frame.width;
+        band.height = S * rows;
+        band.step = frame.step / S;
+        band.originCol = S * frame.originCol - S / 2;
+        band.originRow = S * (frame.originRow + firstRow) - S / 2;
+        samples.assign(band.width * band.height, 0);
+        known.assign(band.width * band.height, 1);
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < frame.width; col++) {
+                if (!refined[row * frame.width + col]) {
+                    continue;
+                }
+                for (int j = 0; j < S; j++) {
+                    char* line = &known[(S * row + j) * band.width + S * col];
+                    std::fill(line, line + S, 0);
+                }
+                int centre = (S * row + S / 2) * band.width + S * col + S / 2;
+                samples[centre] = depths[(firstRow + row) * frame.width + col];
+                known[centre] = 1;
+            }
+        }
+        renderer.renderUnknown(band, maxDepth, &samples[0], known);
+        stats.iterations += renderer.getStats().iterations;
+        stats.interiorSkipped += renderer.getStats().interiorSkipped;
+
+        /* Color of refined pixel is average of its samples' colors */
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < frame.width; col++) {
+                if (!refined[row * frame.width + col]) {
+                    continue;
+                }
+                int red = 0;
+                int green = 0;
+                int blue = 0;
+                for (int j = 0; j < S; j++) {
+                    const int* line = &samples[(S * row + j) * band.width + S * col];
+                    for (int i = 0; i < S; i++) {
+                        int color = palette.getColor(line[i]);
+                        red += (color >> 16) & 0xff;
+                        green += (color >> 8) & 0xff;
+                        blue += color & 0xff;
+                    }
+                }
+                int half = S * S / 2;
+                rgb[(firstRow + row) * frame.width + col] = (((red + half) / (S * S)) << 16)
+                        | (((green + half) / (S * S)) << 8) | ((blue + half) / (S * S));
+            }
+        }
+    }
+}
@@ -0,0 +1,75 @@
+/********************************************************************************************
+* File: antialias.h
+* ----------------------
+* v.1 2026/10/17
+* - supersampling of pixels at edges of depth areas
+*
+* Antialiasing which costs little where image is smooth.
+********************************************************************************************/
+
+#ifndef _antialias_h
+#define _antialias_h
+
+#include <vector>
+#include "palette.h"
+#include "tilerenderer.h"
+
+/* Class: EdgeAntialiaser
+ * ----------------------
+ * Colorizes frame with antialiasing of edges. Pixel whose depth
+ * differs from depth of a neighbour (left, right, top or bottom)
+ * by more than threshold is refined: its color is the average
+ * of SAMPLES_PER_SIDE x SAMPLES_PER_SIDE samples over pixel area.
+ * Other pixels have color of their depth. Pixel's own depth is
+ * one of its samples, so refined pixel costs 15 new samples.
+ * Near the set border most pixels are refined, smooth areas far
+ * from it need no samples at all.  */
+class EdgeAntialiaser {
+public:
+    /* Constructor: EdgeAntialiaser
+     * ----------------------------
+     * @param renderer      Renderer of samples, its options are used as they are
+     * @param threshold     Depth difference with neighbour which needs refining  */
+    explicit EdgeAntialiaser(TileRenderer& renderer, int threshold = DEFAULT_THRESHOLD);
+
+    /* Method: antialias
+     * -----------------
+     * Fills rgb[row * frame.width + col] with colors of the frame,
+     * whose iterations quantities are depths. Samples are calculated
+     * with limit maxDepth, which must be the limit of depths and of
+     * palette (depthLimit in adaptive depth mode).
+     * The first contextAbove and the last contextBelow rows are
+     * neighbours of other rows only: they are colorized, but never
+     * refined.  */
+    void antialias(const FrameGeometry& frame,
+                   int maxDepth,
+                   const int* depths,
+                   const Palette& palette,
+                   int* rgb,
+                   int contextAbove = 0,
+                   int contextBelow = 0);
+
+    /* Method: getStats
+     * ----------------
+     * Returns counters of the last antialias() call: pixels - of the
+     * frame without context rows, pixelsRefined - supersampled ones,
+     * iterations - of samples.  */
+    const RenderStats& getStats() const;
+
+    static int const SAMPLES_PER_SIDE = 4;
+    static int const DEFAULT_THRESHOLD = 1;
+
+private:
+    TileRenderer& renderer;
+    int threshold;
+    RenderStats stats;
+    std::vector<char> refined;  /* Refined pixels of one band of rows */
+    std::vector<int> samples;   /* Samples of the band, SAMPLES_PER_SIDE^2 per pixel */
+    std::vector<char> known;
+
+    /* Antialiaser can't be copied */
+    EdgeAntialiaser(const EdgeAntialiaser&);
+    EdgeAntialiaser& operator=(const EdgeAntialiaser&);
+};
+
+#endif
@@ -0,0 +1,127 @@
+/********************************************************************************************
+* File: bandrenderer.cpp
+* ----------------------
+* v.1 2026/10/17
+* - image is rendered and written to file band by band,
+* - bands are written to any raster sink,
+* - optional edge antialiasing,
+* - render profile of all bands
+*
+* Implementation of the bandrenderer.h interface.
+********************************************************************************************/
+
+#include "bandrenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+BandRenderer::BandRenderer(TileRenderer& renderer, int bandRows)
+        : renderer(renderer),
+          bandRows(std::max(1, bandRows)),
+          antialiaser(NULL) {
+}
+
+void BandRenderer::setAntialiaser(EdgeAntialiaser* antialiaser) {
+    this->antialiaser = antialiaser;
+}
+
+const RenderStats& BandRenderer::getStats() const {
+    return stats;
+}
+
+const RenderProfile& BandRenderer::getProfile() const {
+    return profile;
+}
+
+/* Implementation notes: render
+ * --------------------------------------------------------------------
+ * Band k is written by a separate thread while band k + 1 is
+ * calculated and colorized into the other rgb buffer. Writer of
+ * band k is joined before band k + 1 is written, so file gets
+ * rows in order, and each buffer is used by one thread at a time.
+ * Antialiased band has context rows: rows firstRow - 1 and
+ * firstRow + rowCount are rendered and colorized too, but only
+ * rows between them are written.
+ * --------------------------------------------------------------------*/
+bool BandRenderer::render(const FrameGeometry& frame,
+                          int maxDepth,
+                          const Palette& palette,
+                          RasterSink& sink,
+                          std::string& error) {
+    stats = RenderStats();
+    profile = RenderProfile();
+    profile.width = frame.width;
+    profile.height = frame.height;
+    profile.threads = renderer.getThreadCount();
+#ifndef MANDELBROT_NO_TILE_PROFILE
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point renderStart = Clock::now();
+#endif
+    error = "";
+    int rows = std::min(bandRows, frame.height);
+    int context = (antialiaser != NULL) ? 1 : 0;
+    size_t bandSize = (size_t) frame.width * (rows + 2 * context);
+    depths.assign(bandSize, 0);
+    rgb[0].assign(bandSize, 0);
+    rgb[1].assign(bandSize, 0);
+
+    std::thread writing;
+    std::string writeError;
+    bool written = true;
+    int current = 0;
+    for (int firstRow = 0; firstRow < frame.height && written; firstRow += rows) {
+        int rowCount = std::min(rows, frame.height - firstRow);
+        int top = std::max(0, firstRow - context);
+        int bottom = std::min(frame.height, firstRow + rowCount + context);
+        renderer.renderRows(frame, top, bottom - top, maxDepth, &depths[0]);
+        stats.add(renderer.getStats());
+#ifndef MANDELBROT_NO_TILE_PROFILE
+        const std::vector<TileProfile>& tiles = renderer.getTileProfiles();
+        for (size_t i = 0; i < tiles.size(); i++) {
+            profile.tiles.push_back(tiles[i]);
+            profile.tiles.back().y += top;
+        }
+#endif
+        if (antialiaser != NULL) {
+            FrameGeometry band = frame;
+            band.originRow += top;
+            band.height = bottom - top;
+            antialiaser->antialias(band, palette.getMaxDepth(), &depths[0], palette,
+                                   &rgb[current][0], firstRow - top,
+                                   bottom - (firstRow + rowCount));
+            const RenderStats& antialiasStats = antialiaser->getStats();
+            stats.iterations += antialiasStats.iterations;
+            stats.pixelsRefined += antialiasStats.pixelsRefined;
+        } else {
+            palette.colorize(&depths[0], frame.width * (bottom - top), &rgb[current][0]);
+        }
+
+        if (writing.joinable()) {
+#ifndef MANDELBROT_NO_TILE_PROFILE
+            Clock::time_point waitStart = Clock::now();
+            writing.join();
+            profile.writeWaitSeconds +=
+                    std::chrono::duration<double>(Clock::now() - waitStart).count();
+#else
+            writing.join();
+#endif
+        }
+        written = writeError.empty();
+        if (written) {
+            const int* band = &rgb[current][0] + (firstRow - top) * frame.width;
+            int width = frame.width;
+            writing = std::thread([&sink, &writeError, band, firstRow, width, rowCount]() {
+                sink.writeRect(0, firstRow, width, rowCount, band, writeError);
+            });
+        }
+        current = 1 - current;
+    }
+    if (writing.joinable()) {
+        writing.join();
+    }
+#ifndef MANDELBROT_NO_TILE_PROFILE
+    profile.renderSeconds = std::chrono::duration<double>(Clock::now() - renderStart).count();
+#endif
+    error = writeError;
+    return error.empty();
+}
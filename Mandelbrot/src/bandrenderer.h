@@ -0,0 +1,87 @@
+/********************************************************************************************
+* File: bandrenderer.h
+* ----------------------
+* v.1 2026/10/17
+* - image is rendered and written to file band by band,
+* - bands are written to any raster sink,
+* - optional edge antialiasing,
+* - render profile of all bands
+*
+* Render of images bigger than memory, for posters.
+********************************************************************************************/
+
+#ifndef _bandrenderer_h
+#define _bandrenderer_h
+
+#include <string>
+#include <vector>
+#include "antialias.h"
+#include "palette.h"
+#include "rastersink.h"
+#include "tilerenderer.h"
+
+/* Class: BandRenderer
+ * -------------------
+ * Renders frame as horizontal bands of rows from the top. Every
+ * band is colorized and written to file as soon as it is ready,
+ * while the next band is calculated. Memory holds iterations of
+ * one band and colors of two bands only, whatever the image size
+ * is: 50000 x 50000 poster with 64-row bands needs about 40 MB.  */
+class BandRenderer {
+public:
+    /* Constructor: BandRenderer
+     * -------------------------
+     * @param renderer      Renderer of bands, its options are used as they are
+     * @param bandRows      Rows of one band  */
+    explicit BandRenderer(TileRenderer& renderer, int bandRows = DEFAULT_BAND_ROWS);
+
+    /* Method: render
+     * --------------
+     * Renders frame and writes its bands to sink, which must be
+     * ready for frame size. Returns false and sets error if sink
+     * can't write; writing stops at the first error.  */
+    bool render(const FrameGeometry& frame,
+                int maxDepth,
+                const Palette& palette,
+                RasterSink& sink,
+                std::string& error);
+
+    /* Method: setAntialiaser
+     * -----------------------
+     * Turns on antialiasing of bands by antialiaser, NULL turns
+     * it off (default). Band is rendered with one more row above
+     * and below it, so pixels at band edges have all neighbours.  */
+    void setAntialiaser(EdgeAntialiaser* antialiaser);
+
+    /* Method: getStats
+     * ----------------
+     * Returns counters of the last render() call, summed for all bands.  */
+    const RenderStats& getStats() const;
+
+    /* Method: getProfile
+     * ------------------
+     * Returns tile profiles of all bands of the last render() call
+     * in frame rows, render time and time which render waited for
+     * the writer of the previous band. Tiles of context rows of
+     * antialiased bands are rendered twice and listed twice.
+     * With MANDELBROT_NO_TILE_PROFILE defined, profile has frame
+     * size and threads only.  */
+    const RenderProfile& getProfile() const;
+
+    static int const DEFAULT_BAND_ROWS = 64;
+
+private:
+    TileRenderer& renderer;
+    int bandRows;
+    EdgeAntialiaser* antialiaser;
+    RenderStats stats;
+    RenderProfile profile;
+    std::vector<int> depths;    /* Iterations of the band being calculated */
+    std::vector<int> rgb[2];    /* Colors of the band being written and of the next one */
+
+    /* Renderer can't be copied */
+    BandRenderer(const BandRenderer&);
+    BandRenderer& operator=(const BandRenderer&);
+};
+
+#endif
@@ -0,0 +1,150 @@
+/********************************************************************************************
+* File: deepzoom.cpp
+* ----------------------
+* v.1 2026/10/17
+* - perturbation render with one high precision reference orbit,
+* - glitch detection and rebasing
+*
+* Implementation of the deepzoom.h interface.
+********************************************************************************************/
+
+#include "deepzoom.h"
+#include <algorithm>
+#include <cfloat>
+#include <sstream>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const DEEP_ZOOM_TILE_SIZE = 32;         /* Pixels are shared between threads by tiles */
+double const ESCAPE_LENGTH = 4;             /* |z|^2 limit, the same as kernel has */
+
+PerturbationRenderer::PerturbationRenderer(int threadCount)
+        : pool(threadCount) {
+}
+
+const DeepZoomStats& PerturbationRenderer::getStats() const {
+    return stats;
+}
+
+int PerturbationRenderer::getThreadCount() const {
+    return pool.getThreadCount();
+}
+
+bool PerturbationRenderer::render(const DeepZoomFrame& frame,
+                                  int maxDepth,
+                                  int* depths,
+                                  std::string& error) {
+    stats = DeepZoomStats();
+    if (!(frame.step >= DBL_MIN && frame.step <= DBL_MAX)) {
+        std::ostringstream out;
+        out << "step " << frame.step << " is out of double range, it must be from "
+            << DBL_MIN << " to " << DBL_MAX;
+        error = out.str();
+        return false;
+    }
+    stats.precisionBits = HighPrecision::bitsForStep(frame.step);
+    HighPrecision centreRe = HighPrecision::parse(frame.centreRe, stats.precisionBits, error);
+    if (!error.empty()) {
+        return false;
+    }
+    HighPrecision centreIm = HighPrecision::parse(frame.centreIm, stats.precisionBits, error);
+    if (!error.empty()) {
+        return false;
+    }
+    calculateReferenceOrbit(centreRe, centreIm, maxDepth);
+
+    int tileCols = (frame.width + DEEP_ZOOM_TILE_SIZE - 1) / DEEP_ZOOM_TILE_SIZE;
+    int tileRows = (frame.height + DEEP_ZOOM_TILE_SIZE - 1) / DEEP_ZOOM_TILE_SIZE;
+    std::vector<DeepZoomStats> workerStats(pool.getThreadCount());
+    pool.run(tileCols * tileRows, [&](int task, int worker) {
+        int left = (task % tileCols) * DEEP_ZOOM_TILE_SIZE;
+        int top = (task / tileCols) * DEEP_ZOOM_TILE_SIZE;
+        int right = std::min(left + DEEP_ZOOM_TILE_SIZE, frame.width);
+        int bottom = std::min(top + DEEP_ZOOM_TILE_SIZE, frame.height);
+        for (int row = top; row < bottom; row++) {
+            /* Pixel difference with the centre is small enough for double */
+            double dcIm = (row - frame.height / 2) * frame.step;
+            for (int col = left; col < right; col++) {
+                double dcRe = (col - frame.width / 2) * frame.step;
+                depths[row * frame.width + col] =
+                        calculatePixel(dcRe, dcIm, maxDepth, workerStats[worker]);
+            }
+        }
+    });
+
+    for (size_t i = 0; i < workerStats.size(); i++) {
+        stats.iterations += workerStats[i].iterations;
+        stats.glitchedPixels += workerStats[i].glitchedPixels;
+        stats.rebases += workerStats[i].rebases;
+    }
+    return true;
+}
+
+void PerturbationRenderer::calculateReferenceOrbit(const HighPrecision& re,
+                                                   const HighPrecision& im,
+                                                   int maxDepth) {
+    orbitRe.assign(1, 0.0);
+    orbitIm.assign(1, 0.0);
+    HighPrecision zR(0, stats.precisionBits);
+    HighPrecision zI(0, stats.precisionBits);
+    for (int iter = 1; iter <= maxDepth; iter++) {
+        HighPrecision buf = (zR * zR) - (zI * zI) + re;
+        zI = (zR * zI).multiplyByPowerOfTwo(1) + im;
+        zR = buf;
+        double r = zR.toDouble();
+        double i = zI.toDouble();
+        orbitRe.push_back(r);
+        orbitIm.push_back(i);
+        if ((r * r) + (i * i) >= ESCAPE_LENGTH) {
+            break;
+        }
+    }
+    stats.referenceLength = (int) orbitRe.size() - 1;
+}
+
+int PerturbationRenderer::calculatePixel(double dcRe,
+                                         double dcIm,
+                                         int maxDepth,
+                                         DeepZoomStats& pixelStats) const {
+    int referenceLength = (int) orbitRe.size() - 1;
+    double dR = 0;      /* Difference with reference: d = z - Z */
+    double dI = 0;
+    int m = 0;          /* Current index in reference orbit */
+    bool glitched = false;
+    int iter = 0;
+    while (iter < maxDepth) {
+        double refR = orbitRe[m];
+        double refI = orbitIm[m];
+        /* d(n+1) = 2 * Z(n) * d(n) + d(n)^2 + dc */
+        double nextR = 2 * (refR * dR - refI * dI) + (dR * dR - dI * dI) + dcRe;
+        double nextI = 2 * (refR * dI + refI * dR) + (2 * dR * dI) + dcIm;
+        dR = nextR;
+        dI = nextI;
+        m++;
+        iter++;
+
+        double zR = orbitRe[m] + dR;
+        double zI = orbitIm[m] + dI;
+        double zLength = (zR * zR) + (zI * zI);
+        if (zLength >= ESCAPE_LENGTH) {
+            break;
+        }
+
+        /* Glitch: z came closer to 0 than to reference orbit,
+         * or reference orbit is over - z becomes new difference
+         * with reference orbit which starts again from Z(0) = 0 */
+        bool glitch = zLength < (dR * dR) + (dI * dI);
+        if (glitch || m == referenceLength) {
+            dR = zR;
+            dI = zI;
+            m = 0;
+            glitched |= glitch;
+            pixelStats.rebases++;
+        }
+    }
+    pixelStats.iterations += iter;
+    if (glitched) {
+        pixelStats.glitchedPixels++;
+    }
+    return iter;
+}
@@ -0,0 +1,102 @@
+/********************************************************************************************
+* File: deepzoom.h
+* ----------------------
+* v.1 2026/10/17
+* - perturbation render with one high precision reference orbit,
+* - glitch detection and rebasing
+*
+* Deep zooms of the Mandelbrot set, far beyond double precision.
+********************************************************************************************/
+
+#ifndef _deepzoom_h
+#define _deepzoom_h
+
+#include <string>
+#include <vector>
+#include "highprecision.h"
+#include "workpool.h"
+
+/* Type: DeepZoomFrame
+ * -------------------
+ * Image size and its position on complex area. Centre is kept
+ * in decimal form with any quantity of digits, step is the complex
+ * distance between neighbour pixels (1e-100 is fine for double).
+ * Differences with the centre are doubles, so step must be a normal
+ * positive double, at least DBL_MIN (about 2.2e-308).
+ * Pixel (col, row) represents c-point:
+ *   a = centreRe + (col - width / 2) * step,
+ *   b = centreIm + (row - height / 2) * step.  */
+struct DeepZoomFrame {
+    int width;
+    int height;
+    std::string centreRe;
+    std::string centreIm;
+    double step;
+};
+
+/* Type: DeepZoomStats
+ * -------------------
+ * Counters of one render() call.  */
+struct DeepZoomStats {
+    int referenceLength;        /* Iterations of reference orbit */
+    int precisionBits;          /* Fraction bits of reference orbit */
+    long long iterations;       /* Iterations made by all pixels */
+    long long glitchedPixels;   /* Pixels which glitched at least once */
+    long long rebases;          /* Rebases made by all pixels, after glitch or
+                                 * at the end of reference orbit */
+
+    DeepZoomStats()
+            : referenceLength(0), precisionBits(0), iterations(0),
+              glitchedPixels(0), rebases(0) {}
+};
+
+/* Class: PerturbationRenderer
+ * ---------------------------
+ * Calculates iterations quantities for DeepZoomFrame.
+ *
+ * Only one orbit - of the frame centre - is calculated with
+ * high precision: Z(n+1) = Z(n)^2 + C. Every pixel c = C + dc
+ * iterates in double precision only its small difference with it:
+ *   z(n) = Z(n) + d(n),
+ *   d(n+1) = 2 * Z(n) * d(n) + d(n)^2 + dc.
+ * When |z| becomes smaller than |d|, difference is not small any
+ * more and its precision is lost (pixel "glitches"). Then pixel is
+ * rebased: d = z, and reference orbit is followed from its start
+ * again, Z(0) = 0. The same happens when pixel outlives the
+ * reference orbit, which escaped or reached maxDepth.  */
+class PerturbationRenderer {
+public:
+    /* Constructor: PerturbationRenderer
+     * ---------------------------------
+     * @param threadCount   Quantity of threads, <= 0 - one per hardware thread  */
+    explicit PerturbationRenderer(int threadCount = 0);
+
+    /* Method: render
+     * --------------
+     * Fills depths[row * frame.width + col] with iterations
+     * quantity for every pixel of the frame.
+     * Returns false and sets error if frame centre is not a number
+     * or step is out of the range described at DeepZoomFrame.  */
+    bool render(const DeepZoomFrame& frame, int maxDepth, int* depths, std::string& error);
+
+    /* Method: getStats
+     * ----------------
+     * Returns counters of the last render() call.  */
+    const DeepZoomStats& getStats() const;
+
+    /* Method: getThreadCount
+     * ----------------------
+     * Returns quantity of threads which calculate pixels.  */
+    int getThreadCount() const;
+
+private:
+    WorkStealingPool pool;
+    DeepZoomStats stats;
+    std::vector<double> orbitRe;    /* Reference orbit Z(0) ... Z(referenceLength) */
+    std::vector<double> orbitIm;
+
+    void calculateReferenceOrbit(const HighPrecision& re, const HighPrecision& im, int maxDepth);
+    int calculatePixel(double dcRe, double dcIm, int maxDepth, DeepZoomStats& pixelStats) const;
+};
+
+#endif
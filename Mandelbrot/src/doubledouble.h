@@ -0,0 +1,124 @@
+/********************************************************************************************
+* File: doubledouble.h
+* ----------------------
+* v.1 2026/10/17
+* - double-double numbers for scalars and vectors
+*
+* About 106-bit real numbers made of two doubles.
+********************************************************************************************/
+
+#ifndef _doubledouble_h
+#define _doubledouble_h
+
+/* Type: DoubleDoubleOf
+ * --------------------
+ * Real number hi + lo, where lo is smaller than half of the last
+ * bit of hi. It has twice more mantissa bits than double, with
+ * the same exponent range.
+ * T is double, or vector of doubles (GCC vector extensions):
+ * then every lane is a separate number, and all operations are
+ * made for all lanes at once.
+ *
+ * Operations are error-free transformations of Dekker and Knuth,
+ * they need strict IEEE double arithmetic: compiler must not fuse
+ * multiplication and addition (no FMA contraction), and x87
+ * extended registers must not be used.  */
+template <typename T>
+struct DoubleDoubleOf {
+    T hi;
+    T lo;
+
+    inline __attribute__((always_inline))
+    DoubleDoubleOf() : hi(), lo() {}
+
+    inline __attribute__((always_inline))
+    DoubleDoubleOf(const T& value) : hi(value), lo() {}
+
+    inline __attribute__((always_inline))
+    DoubleDoubleOf(const T& hi, const T& lo) : hi(hi), lo(lo) {}
+};
+
+typedef DoubleDoubleOf<double> DoubleDouble;
+
+/* Implementation notes
+ * --------------------------------------------------------------------
+ * twoSum: s + err = a + b exactly.
+ * quickTwoSum: the same, when |a| >= |b|.
+ * twoProduct: p + err = a * b exactly; every factor is split
+ * in two 26-bit halves, so products of halves are exact.
+ * Sum and product of double-doubles keep about 104 bits.
+ * --------------------------------------------------------------------*/
+namespace doubledouble {
+
+double const SPLITTER = 134217729.0;    /* 2^27 + 1 */
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> twoSum(const T& a, const T& b) {
+    T s = a + b;
+    T bb = s - a;
+    return DoubleDoubleOf<T>(s, (a - (s - bb)) + (b - bb));
+}
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> quickTwoSum(const T& a, const T& b) {
+    T s = a + b;
+    return DoubleDoubleOf<T>(s, b - (s - a));
+}
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> twoProduct(const T& a, const T& b) {
+    T p = a * b;
+    T t = SPLITTER * a;
+    T aHi = t - (t - a);
+    T aLo = a - aHi;
+    t = SPLITTER * b;
+    T bHi = t - (t - b);
+    T bLo = b - bHi;
+    return DoubleDoubleOf<T>(p, (((aHi * bHi) - p) + (aHi * bLo) + (aLo * bHi)) + (aLo * bLo));
+}
+
+} // namespace doubledouble
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> operator+(const DoubleDoubleOf<T>& x, const DoubleDoubleOf<T>& y) {
+    DoubleDoubleOf<T> s = doubledouble::twoSum(x.hi, y.hi);
+    return doubledouble::quickTwoSum(s.hi, s.lo + (x.lo + y.lo));
+}
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> operator-(const DoubleDoubleOf<T>& x) {
+    return DoubleDoubleOf<T>(-x.hi, -x.lo);
+}
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> operator-(const DoubleDoubleOf<T>& x, const DoubleDoubleOf<T>& y) {
+    return x + (-y);
+}
+
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> operator*(const DoubleDoubleOf<T>& x, const DoubleDoubleOf<T>& y) {
+    DoubleDoubleOf<T> p = doubledouble::twoProduct(x.hi, y.hi);
+    return doubledouble::quickTwoSum(p.hi, p.lo + ((x.hi * y.lo) + (x.lo * y.hi)));
+}
+
+/* Function: twice
+ * ---------------
+ * Returns 2 * x, it is exact and needs no splitting.  */
+template <typename T>
+inline __attribute__((always_inline))
+DoubleDoubleOf<T> twice(const DoubleDoubleOf<T>& x) {
+    return DoubleDoubleOf<T>(x.hi + x.hi, x.lo + x.lo);
+}
+
+inline bool operator<(const DoubleDouble& x, double y) {
+    return (x.hi < y) || ((x.hi == y) && (x.lo < 0));
+}
+
+#endif
@@ -0,0 +1,119 @@
+/********************************************************************************************
+* File: framecache.cpp
+* ----------------------
+* v.1 2026/10/17
+* - iterations quantities of the last frame are reused after panning
+*
+* Implementation of the framecache.h interface.
+********************************************************************************************/
+
+#include "framecache.h"
+#include <algorithm>
+#include <cstdlib>
+
+FrameCache::FrameCache(TileRenderer& renderer)
+        : renderer(renderer),
+          maxDepth(0),
+          valid(false) {
+}
+
+const RenderStats& FrameCache::getStats() const {
+    return stats;
+}
+
+void FrameCache::clear() {
+    valid = false;
+}
+
+void FrameCache::setFrame(const FrameGeometry& frame,
+                          int maxDepth,
+                          const std::vector<int>& depths) {
+    this->frame = frame;
+    this->maxDepth = maxDepth;
+    this->depths = depths;
+    valid = true;
+}
+
+/* Implementation notes: render
+ * --------------------------------------------------------------------
+ * Frame panned by (dx, dy) has pixel (col, row) of the last frame
+ * at (col - dx, row - dy). Exposed columns are calculated at
+ * full height, exposed rows - only between them:
+ *
+ *   dx > 0, dy > 0:  +---------+--+
+ *                    |  moved  |  |
+ *                    +---------+  |
+ *                    |  rows   |  |
+ *                    +---------+--+
+ * --------------------------------------------------------------------*/
+const std::vector<int>& FrameCache::render(const Viewport& view, int maxDepth) {
+    FrameGeometry next = view.getFrameGeometry();
+    stats = RenderStats();
+    bool panned = isPannedFrame(next, maxDepth);
+    this->maxDepth = maxDepth;
+    if (!panned) {
+        depths.assign(next.width * next.height, 0);
+        renderRect(next, 0, 0, next.width, next.height);
+    } else {
+        int dx = next.originCol - frame.originCol;
+        int dy = next.originRow - frame.originRow;
+        shifted.assign(next.width * next.height, 0);
+        int left = std::max(0, -dx);        /* Moved part of the new frame */
+        int right = std::min(next.width, next.width - dx);
+        int top = std::max(0, -dy);
+        int bottom = std::min(next.height, next.height - dy);
+        for (int row = top; row < bottom; row++) {
+            const int* from = &depths[(row + dy) * next.width + (left + dx)];
+            std::copy(from, from + (right - left), &shifted[row * next.width + left]);
+        }
+        depths.swap(shifted);
+        stats.pixelsReused = (long long) (right - left) * (bottom - top);
+
+        if (left > 0) {
+            renderRect(next, 0, 0, left, next.height);
+        }
+        if (right < next.width) {
+            renderRect(next, right, 0, next.width - right, next.height);
+        }
+        if (top > 0) {
+            renderRect(next, left, 0, right - left, top);
+        }
+        if (bottom < next.height) {
+            renderRect(next, left, bottom, right - left, next.height - bottom);
+        }
+    }
+    stats.pixels += stats.pixelsReused;
+    frame = next;
+    valid = true;
+    return depths;
+}
+
+bool FrameCache::isPannedFrame(const FrameGeometry& next, int nextMaxDepth) const {
+    return valid
+            && nextMaxDepth == maxDepth
+            && next.width == frame.width
+            && next.height == frame.height
+            && next.step == frame.step
+            && next.reLeft == frame.reLeft
+            && next.imTop == frame.imTop
+            && next.reLeftLow == frame.reLeftLow
+            && next.imTopLow == frame.imTopLow
+            && std::abs(next.originCol - frame.originCol) < next.width
+            && std::abs(next.originRow - frame.originRow) < next.height;
+}
+
+void FrameCache::renderRect(const FrameGeometry& next, int x, int y, int width, int height) {
+    /* Part of the picture: the same anchor, shifted origin */
+    FrameGeometry rect = next;
+    rect.width = width;
+    rect.height = height;
+    rect.originCol += x;
+    rect.originRow += y;
+    strip.resize(width * height);
+    renderer.render(rect, maxDepth, &strip[0]);
+    for (int row = 0; row < height; row++) {
+        std::copy(&strip[row * width], &strip[row * width] + width,
+                  &depths[(y + row) * next.width + x]);
+    }
+    stats.add(renderer.getStats());
+}
@@ -0,0 +1,73 @@
+/********************************************************************************************
+* File: framecache.h
+* ----------------------
+* v.1 2026/10/17
+* - iterations quantities of the last frame are reused after panning
+*
+* Incremental render of a panned viewport.
+********************************************************************************************/
+
+#ifndef _framecache_h
+#define _framecache_h
+
+#include <vector>
+#include "tilerenderer.h"
+#include "viewport.h"
+
+/* Class: FrameCache
+ * -----------------
+ * Keeps iterations quantities of the last rendered frame. When the
+ * next frame is the same picture panned by less than its size,
+ * buffer is shifted and only newly exposed strips are calculated:
+ * panning by a few percent of the frame costs a few percent of
+ * a full render. Any other frame is rendered completely.  */
+class FrameCache {
+public:
+    /* Constructor: FrameCache
+     * -----------------------
+     * @param renderer      Renderer of exposed strips, its
+     *                      options are used as they are  */
+    explicit FrameCache(TileRenderer& renderer);
+
+    /* Method: render
+     * --------------
+     * Returns iterations quantities of view's frame, row by row.  */
+    const std::vector<int>& render(const Viewport& view, int maxDepth);
+
+    /* Method: setFrame
+     * ----------------
+     * Remembers frame which was rendered by other way
+     * (for example, progressively) for the next render() call.  */
+    void setFrame(const FrameGeometry& frame, int maxDepth, const std::vector<int>& depths);
+
+    /* Method: getStats
+     * ----------------
+     * Returns counters of the last render() call: pixels of the
+     * frame, pixelsReused - pixels moved from the last frame,
+     * the other counters - of calculated strips.  */
+    const RenderStats& getStats() const;
+
+    /* Method: clear
+     * -------------
+     * Forgets the last frame.  */
+    void clear();
+
+private:
+    TileRenderer& renderer;
+    FrameGeometry frame;        /* The last frame */
+    int maxDepth;
+    bool valid;
+    std::vector<int> depths;
+    std::vector<int> shifted;   /* Buffers for shift and strips, */
+    std::vector<int> strip;     /* kept between calls */
+    RenderStats stats;
+
+    bool isPannedFrame(const FrameGeometry& next, int nextMaxDepth) const;
+    void renderRect(const FrameGeometry& next, int x, int y, int width, int height);
+
+    /* Cache can't be copied */
+    FrameCache(const FrameCache&);
+    FrameCache& operator=(const FrameCache&);
+};
+
+#endif
@@ -0,0 +1,240 @@
+/********************************************************************************************
+* File: highprecision.cpp
+* ----------------------
+* v.1 2026/10/17
+* - fixed-point real numbers with precision chosen at runtime
+*
+* Implementation of the highprecision.h interface.
+********************************************************************************************/
+
+#include "highprecision.h"
+#include <algorithm>
+#include <cmath>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const LIMB_BITS = 32;
+int const GUARD_BITS = 64;          /* Extra bits for rounding errors of long orbits */
+int const MAX_INTEGER_DIGITS = 9;   /* Integer part must fit into one limb */
+
+/*------------------------------------------------------------------------------------------//
+ * Implementation section.
+ * -----------------------
+ * Number with n limbs is integer A = limbs * 2^(32 * (n - 1)) in
+ * two's complement form. Sum of numbers is sum of such integers.
+ * Product is A * B / 2^(32 * (n - 1)): magnitudes are multiplied
+ * by school method, and the lowest n - 1 limbs are dropped.
+ * -----------------------------------------------------------------------------------------*/
+
+HighPrecision::HighPrecision(double value, int fractionBits) {
+    int fractionLimbs = std::max(2, (fractionBits + LIMB_BITS - 1) / LIMB_BITS);
+    limbs.assign(1 + fractionLimbs, 0);
+
+    /* Every double is converted exactly, 32 bits per limb */
+    double magnitude = std::fabs(value);
+    double integerPart = std::floor(magnitude);
+    double fraction = magnitude - integerPart;
+    limbs[0] = (uint32_t) integerPart;
+    for (size_t k = 1; k < limbs.size() && fraction > 0; k++) {
+        fraction = std::ldexp(fraction, LIMB_BITS);
+        double digit = std::floor(fraction);
+        limbs[k] = (uint32_t) digit;
+        fraction -= digit;
+    }
+    if (value < 0) {
+        negate();
+    }
+}
+
+HighPrecision HighPrecision::parse(const std::string& text, int fractionBits, std::string& error) {
+    HighPrecision result(0, fractionBits);
+    error = "";
+
+    /* Optional decimal exponent: "-4.24e-13" */
+    std::string mantissa = text;
+    int exponent = 0;
+    size_t e = text.find_first_of("eE");
+    if (e != std::string::npos) {
+        mantissa = text.substr(0, e);
+        std::string digits = text.substr(e + 1);
+        bool negativeExponent = !digits.empty() && digits[0] == '-';
+        if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) {
+            digits = digits.substr(1);
+        }
+        if (digits.empty() || digits.length() > 4
+                || digits.find_first_not_of("0123456789") != std::string::npos) {
+            error = "invalid exponent in \"" + text + "\"";
+            return result;
+        }
+        exponent = std::stoi(digits);
+        if (negativeExponent) {
+            exponent = -exponent;
+        }
+    }
+
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < mantissa.length() && (mantissa[pos] == '-' || mantissa[pos] == '+')) {
+        negative = (mantissa[pos] == '-');
+        pos++;
+    }
+    size_t point = mantissa.find('.', pos);
+    std::string integerDigits = mantissa.substr(pos, point == std::string::npos
+                                                     ? std::string::npos : point - pos);
+    std::string fractionDigits = (point == std::string::npos) ? "" : mantissa.substr(point + 1);
+    if ((integerDigits.empty() && fractionDigits.empty())
+            || integerDigits.find_first_not_of("0123456789") != std::string::npos
+            || fractionDigits.find_first_not_of("0123456789") != std::string::npos) {
+        error = "number expected: \"" + text + "\"";
+        return result;
+    }
+
+    /* Positive exponent moves digits from fraction to integer part,
+     * negative one - from integer part to fraction */
+    std::string digits = integerDigits + fractionDigits;
+    int pointPosition = (int) integerDigits.length() + exponent;
+    if (pointPosition < 0) {
+        digits = std::string(-pointPosition, '0') + digits;
+        pointPosition = 0;
+    } else if (pointPosition > (int) digits.length()) {
+        digits += std::string(pointPosition - digits.length(), '0');
+    }
+    integerDigits = digits.substr(0, pointPosition);
+    fractionDigits = digits.substr(pointPosition);
+    integerDigits.erase(0, std::min(integerDigits.find_first_not_of('0'), integerDigits.length()));
+    if (integerDigits.length() > (size_t) MAX_INTEGER_DIGITS) {
+        error = "number is too big: \"" + text + "\"";
+        return result;
+    }
+
+    /* Fraction is accumulated from its last digit:
+     * v = (v + digit) / 10 */
+    for (size_t i = fractionDigits.length(); i > 0; i--) {
+        result.limbs[0] += (uint32_t) (fractionDigits[i - 1] - '0');
+        result.divideBySmall(10);
+    }
+    uint32_t integerPart = 0;
+    for (size_t i = 0; i < integerDigits.length(); i++) {
+        integerPart = integerPart * 10 + (uint32_t) (integerDigits[i] - '0');
+    }
+    if (integerPart > 0x7fffffffu) {
+        error = "number is too big: \"" + text + "\"";
+        return result;
+    }
+    result.limbs[0] = integerPart;
+    if (negative) {
+        result.negate();
+    }
+    return result;
+}
+
+int HighPrecision::bitsForStep(double step) {
+    if (!(step > 0)) {
+        return GUARD_BITS;
+    }
+    return std::max(0, (int) std::ceil(-std::log2(step))) + GUARD_BITS;
+}
+
+double HighPrecision::toDouble() const {
+    HighPrecision magnitude = *this;
+    bool negative = isNegative();
+    if (negative) {
+        magnitude.negate();
+    }
+    double result = 0;
+    for (size_t k = magnitude.limbs.size(); k > 0; k--) {
+        result += std::ldexp((double) magnitude.limbs[k - 1], -LIMB_BITS * (int) (k - 1));
+    }
+    return negative ? -result : result;
+}
+
+HighPrecision HighPrecision::operator+(const HighPrecision& other) const {
+    HighPrecision result = (limbs.size() <= other.limbs.size()) ? *this : other;
+    const HighPrecision& addend = (limbs.size() <= other.limbs.size()) ? other : *this;
+    uint64_t carry = 0;
+    for (size_t k = result.limbs.size(); k > 0; k--) {
+        uint64_t sum = (uint64_t) result.limbs[k - 1] + addend.limbs[k - 1] + carry;
+        result.limbs[k - 1] = (uint32_t) sum;
+        carry = sum >> LIMB_BITS;
+    }
+    return result;
+}
+
+HighPrecision HighPrecision::operator-(const HighPrecision& other) const {
+    return *this + (-other);
+}
+
+HighPrecision HighPrecision::operator-() const {
+    HighPrecision result = *this;
+    result.negate();
+    return result;
+}
+
+HighPrecision HighPrecision::operator*(const HighPrecision& other) const {
+    size_t n = std::min(limbs.size(), other.limbs.size());
+    HighPrecision x = *this;
+    HighPrecision y = other;
+    bool negative = x.isNegative() != y.isNegative();
+    if (x.isNegative()) {
+        x.negate();
+    }
+    if (y.isNegative()) {
+        y.negate();
+    }
+
+    /* Little-endian digits of product of magnitudes */
+    std::vector<uint64_t> product(2 * n, 0);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t carry = 0;
+        uint64_t xi = x.limbs[n - 1 - i];
+        for (size_t j = 0; j < n; j++) {
+            uint64_t cur = product[i + j] + xi * y.limbs[n - 1 - j] + carry;
+            product[i + j] = cur & 0xffffffffu;
+            carry = cur >> LIMB_BITS;
+        }
+        product[i + n] += carry;
+    }
+
+    HighPrecision result = (limbs.size() <= other.limbs.size()) ? *this : other;
+    for (size_t k = 0; k < n; k++) {
+        result.limbs[k] = (uint32_t) product[2 * n - 2 - k];
+    }
+    if (negative) {
+        result.negate();
+    }
+    return result;
+}
+
+HighPrecision HighPrecision::multiplyByPowerOfTwo(int power) const {
+    HighPrecision result = *this;
+    if (power <= 0) {
+        return result;
+    }
+    for (size_t k = 0; k < result.limbs.size(); k++) {
+        uint32_t next = (k + 1 < result.limbs.size()) ? result.limbs[k + 1] : 0;
+        result.limbs[k] = (result.limbs[k] << power) | (next >> (LIMB_BITS - power));
+    }
+    return result;
+}
+
+bool HighPrecision::isNegative() const {
+    return (limbs[0] & 0x80000000u) != 0;
+}
+
+void HighPrecision::negate() {
+    uint64_t carry = 1;
+    for (size_t k = limbs.size(); k > 0; k--) {
+        uint64_t cur = (uint64_t) (uint32_t) ~limbs[k - 1] + carry;
+        limbs[k - 1] = (uint32_t) cur;
+        carry = cur >> LIMB_BITS;
+    }
+}
+
+void HighPrecision::divideBySmall(uint32_t divisor) {
+    uint64_t remainder = 0;
+    for (size_t k = 0; k < limbs.size(); k++) {
+        uint64_t cur = (remainder << LIMB_BITS) | limbs[k];
+        limbs[k] = (uint32_t) (cur / divisor);
+        remainder = cur % divisor;
+    }
+}
@@ -0,0 +1,68 @@
+/********************************************************************************************
+* File: highprecision.h
+* ----------------------
+* v.1 2026/10/17
+* - fixed-point real numbers with precision chosen at runtime
+*
+* Extended precision arithmetic for reference orbits of deep zooms.
+********************************************************************************************/
+
+#ifndef _highprecision_h
+#define _highprecision_h
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/* Class: HighPrecision
+ * --------------------
+ * Fixed-point real number in two's complement form:
+ * limbs[0] is signed integer part, limbs[1...] are 32-bit
+ * fractional digits. Precision is set in constructor,
+ * operations on numbers of different precision are made
+ * with the smaller one.
+ * Only operations needed by Z = Z^2 + C are implemented,
+ * integer part must stay in range (-2^31, 2^31).  */
+class HighPrecision {
+public:
+    /* Constructor: HighPrecision
+     * --------------------------
+     * Creates number with value, which has at least
+     * fractionBits bits after binary point.  */
+    explicit HighPrecision(double value = 0, int fractionBits = 64);
+
+    /* Function: parse
+     * ---------------
+     * Returns number for decimal string like "-0.74364388703715870475"
+     * or "-4.2402439547240753390707e-13", or sets error message in
+     * parameter error if string is not a number.  */
+    static HighPrecision parse(const std::string& text, int fractionBits, std::string& error);
+
+    /* Function: bitsForStep
+     * ---------------------
+     * Returns quantity of fraction bits, which is enough to
+     * resolve complex distance step between neighbour pixels
+     * with 64 guard bits for the error of long orbits.  */
+    static int bitsForStep(double step);
+
+    double toDouble() const;
+
+    HighPrecision operator+(const HighPrecision& other) const;
+    HighPrecision operator-(const HighPrecision& other) const;
+    HighPrecision operator*(const HighPrecision& other) const;
+    HighPrecision operator-() const;
+
+    /* Method: multiplyByPowerOfTwo
+     * ----------------------------
+     * Returns this * 2^power, power in range [0, 31].  */
+    HighPrecision multiplyByPowerOfTwo(int power) const;
+
+private:
+    std::vector<uint32_t> limbs;    /* limbs[0] - integer part, in two's complement */
+
+    bool isNegative() const;
+    void negate();
+    void divideBySmall(uint32_t divisor);
+};
+
+#endif
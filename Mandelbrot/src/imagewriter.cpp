@@ -0,0 +1,360 @@
+/********************************************************************************************
+* File: imagewriter.cpp
+* ----------------------
+* v.3 2026/10/17
+* - image files are raster sinks,
+* - memory-mapped image file
+* v.2 2026/10/17
+* - image is written by bands of rows, whole image is never kept in memory,
+* - BMP rows are top-down
+* v.1 2026/10/17
+* - binary PPM and 24-bit BMP files
+*
+* Implementation of the imagewriter.h interface.
+********************************************************************************************/
+
+#include "imagewriter.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const BMP_HEADER_SIZE = 14 + 40;    /* File header and BITMAPINFOHEADER */
+int const BMP_PIXELS_PER_METER = 2835;  /* 72 DPI */
+long long const BMP_MAX_FILE_SIZE = 0xffffffffLL;
+
+/*------------------------------------------------------------------------------------------//
+ * Implementation section.
+ * -----------------------
+ * PPM: text header "P6\n<width> <height>\n255\n", then rows from
+ * the top, 3 bytes R, G, B per pixel.
+ * BMP: little-endian headers, then rows, 3 bytes B, G, R per pixel,
+ * every row is padded to 4 bytes. Negative height means rows from
+ * the top, so BMP is written in the same order as PPM.
+ * -----------------------------------------------------------------------------------------*/
+
+bool imageFormatForFile(const std::string& filename, ImageFormat& format) {
+    size_t dot = filename.rfind('.');
+    if (dot == std::string::npos) {
+        return false;
+    }
+    std::string extension = filename.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    if (extension == "ppm") {
+        format = IMAGE_PPM;
+        return true;
+    }
+    if (extension == "bmp") {
+        format = IMAGE_BMP;
+        return true;
+    }
+    return false;
+}
+
+/* Function: putLittleEndian
+ * -------------------------
+ * Writes size bytes of value to header, the lowest byte first.  */
+static void putLittleEndian(unsigned char* header, int size, long long value) {
+    for (int i = 0; i < size; i++) {
+        header[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+/* Function: convertRow
+ * --------------------
+ * Converts row of 0xRRGGBB colors into bytes of file.  */
+static void convertRow(const int* rgb, int width, ImageFormat format, unsigned char* bytes) {
+    for (int col = 0; col < width; col++) {
+        unsigned char red = (unsigned char) (rgb[col] >> 16);
+        unsigned char green = (unsigned char) (rgb[col] >> 8);
+        unsigned char blue = (unsigned char) rgb[col];
+        bytes[3 * col] = (format == IMAGE_PPM) ? red : blue;
+        bytes[3 * col + 1] = green;
+        bytes[3 * col + 2] = (format == IMAGE_PPM) ? blue : red;
+    }
+}
+
+/* Function: getRowSize
+ * --------------------
+ * Returns bytes of one image row in file.  */
+static long long getRowSize(ImageFormat format, int width) {
+    long long rowSize = 3LL * width;
+    return (format == IMAGE_BMP) ? (rowSize + 3) / 4 * 4 : rowSize;
+}
+
+/* Function: makeHeader
+ * --------------------
+ * Fills header of width x height image file. Returns false
+ * and sets error if image doesn't fit into format.  */
+static bool makeHeader(ImageFormat format,
+                       int width,
+                       int height,
+                       std::vector<unsigned char>& header,
+                       std::string& error) {
+    long long pixelsSize = getRowSize(format, width) * height;
+    if (format == IMAGE_PPM) {
+        std::string text = "P6\n" + std::to_string(width) + " " + std::to_string(height)
+                + "\n255\n";
+        header.assign(text.begin(), text.end());
+        return true;
+    }
+    if (BMP_HEADER_SIZE + pixelsSize > BMP_MAX_FILE_SIZE) {
+        error = "image is too big for BMP file, use PPM";
+        return false;
+    }
+    header.assign(BMP_HEADER_SIZE, 0);
+    header[0] = 'B';
+    header[1] = 'M';
+    putLittleEndian(&header[2], 4, BMP_HEADER_SIZE + pixelsSize);
+    putLittleEndian(&header[10], 4, BMP_HEADER_SIZE);   /* Offset of pixels */
+    putLittleEndian(&header[14], 4, 40);                /* BITMAPINFOHEADER size */
+    putLittleEndian(&header[18], 4, width);
+    putLittleEndian(&header[22], 4, -height);           /* Negative - top-down rows */
+    putLittleEndian(&header[26], 2, 1);                 /* Planes */
+    putLittleEndian(&header[28], 2, 24);                /* Bits per pixel */
+    putLittleEndian(&header[34], 4, pixelsSize);
+    putLittleEndian(&header[38], 4, BMP_PIXELS_PER_METER);
+    putLittleEndian(&header[42], 4, BMP_PIXELS_PER_METER);
+    return true;
+}
+
+ImageStreamWriter::ImageStreamWriter()
+        : file(NULL),
+          format(IMAGE_PPM),
+          width(0),
+          height(0),
+          rowsWritten(0) {
+}
+
+ImageStreamWriter::~ImageStreamWriter() {
+    if (file != NULL) {
+        fclose(file);
+    }
+}
+
+bool ImageStreamWriter::open(const std::string& filename,
+                             ImageFormat format,
+                             int width,
+                             int height,
+                             std::string& error) {
+    error = "";
+    std::vector<unsigned char> header;
+    if (!makeHeader(format, width, height, header, error)) {
+        return false;
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+    file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        error = "can't open file \"" + filename + "\"";
+        return false;
+    }
+    this->filename = filename;
+    this->format = format;
+    this->width = width;
+    this->height = height;
+    rowsWritten = 0;
+    bytes.assign(getRowSize(format, width), 0);
+    fwrite(&header[0], 1, header.size(), file);
+    if (ferror(file)) {
+        error = "can't write file \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+bool ImageStreamWriter::writeRows(const int* rgb, int rowCount, std::string& error) {
+    error = "";
+    if (file == NULL || rowsWritten + rowCount > height) {
+        error = "rows are out of image \"" + filename + "\"";
+        return false;
+    }
+    for (int row = 0; row < rowCount; row++) {
+        convertRow(rgb + (long long) row * width, width, format, &bytes[0]);
+        fwrite(&bytes[0], 1, bytes.size(), file);
+    }
+    rowsWritten += rowCount;
+    if (ferror(file)) {
+        error = "can't write file \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+bool ImageStreamWriter::writeRect(int x, int y, int width, int height,
+                                  const int* rgb, std::string& error) {
+    if (x != 0 || width != this->width || y != rowsWritten) {
+        error = "only next rows can be written to \"" + filename + "\"";
+        return false;
+    }
+    return writeRows(rgb, height, error);
+}
+
+bool ImageStreamWriter::close(std::string& error) {
+    error = "";
+    if (file == NULL) {
+        return true;
+    }
+    bool written = !ferror(file);
+    if (fclose(file) != 0) {
+        written = false;
+    }
+    file = NULL;
+    if (!written) {
+        error = "can't write file \"" + filename + "\"";
+    } else if (rowsWritten != height) {
+        error = "not all rows are written to \"" + filename + "\"";
+        written = false;
+    }
+    return written;
+}
+
+MappedImageFile::MappedImageFile()
+        : format(IMAGE_PPM),
+          width(0),
+          height(0),
+          rowSize(0),
+          headerSize(0),
+          fileSize(0),
+          pixels(NULL),
+#ifdef _WIN32
+          file(INVALID_HANDLE_VALUE),
+          mapping(NULL) {
+#else
+          file(-1) {
+#endif
+}
+
+MappedImageFile::~MappedImageFile() {
+    std::string error;
+    close(error);
+}
+
+/* Implementation notes: open
+ * --------------------------------------------------------------------
+ * File gets its full size at once, header is written into the
+ * mapped memory as well. Pages which no rectangle touched read
+ * as zero bytes - black pixels.
+ * --------------------------------------------------------------------*/
+bool MappedImageFile::open(const std::string& filename,
+                           ImageFormat format,
+                           int width,
+                           int height,
+                           std::string& error) {
+    error = "";
+    std::vector<unsigned char> header;
+    if (!makeHeader(format, width, height, header, error) || !close(error)) {
+        return false;
+    }
+    this->filename = filename;
+    this->format = format;
+    this->width = width;
+    this->height = height;
+    rowSize = getRowSize(format, width);
+    headerSize = (long long) header.size();
+    fileSize = headerSize + rowSize * height;
+
+#ifdef _WIN32
+    file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                       CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        error = "can't open file \"" + filename + "\"";
+        return false;
+    }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                                 (DWORD) (fileSize >> 32), (DWORD) fileSize, NULL);
+    void* view = (mapping != NULL) ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0) : NULL;
+#else
+    file = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) {
+        error = "can't open file \"" + filename + "\"";
+        return false;
+    }
+    void* view = NULL;
+    if (ftruncate(file, (off_t) fileSize) == 0) {
+        view = mmap(NULL, (size_t) fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        if (view == MAP_FAILED) {
+            view = NULL;
+        }
+    }
+#endif
+    if (view == NULL) {
+        std::string closeError;
+        close(closeError);
+        error = "can't map file \"" + filename + "\" into memory";
+        return false;
+    }
+    pixels = (unsigned char*) view;
+    std::memcpy(pixels, &header[0], header.size());
+    return true;
+}
+
+bool MappedImageFile::writeRect(int x, int y, int width, int height,
+                                const int* rgb, std::string& error) {
+    if (pixels == NULL || x < 0 || y < 0
+            || x + width > this->width || y + height > this->height) {
+        error = "rectangle is out of image \"" + filename + "\"";
+        return false;
+    }
+    for (int row = 0; row < height; row++) {
+        unsigned char* line = pixels + headerSize + (y + row) * rowSize + 3LL * x;
+        convertRow(rgb + (long long) row * width, width, format, line);
+    }
+    return true;
+}
+
+bool MappedImageFile::close(std::string& error) {
+    error = "";
+    bool written = true;
+#ifdef _WIN32
+    if (pixels != NULL) {
+        written = FlushViewOfFile(pixels, 0) != 0;
+        UnmapViewOfFile(pixels);
+    }
+    if (mapping != NULL) {
+        CloseHandle(mapping);
+        mapping = NULL;
+    }
+    if (file != INVALID_HANDLE_VALUE) {
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (pixels != NULL) {
+        written = munmap(pixels, (size_t) fileSize) == 0;
+    }
+    if (file >= 0) {
+        written = (::close(file) == 0) && written;
+        file = -1;
+    }
+#endif
+    pixels = NULL;
+    if (!written) {
+        error = "can't write file \"" + filename + "\"";
+    }
+    return written;
+}
+
+bool writeImage(const std::string& filename,
+                ImageFormat format,
+                int width,
+                int height,
+                const int* rgb,
+                std::string& error) {
+    ImageStreamWriter writer;
+    if (!writer.open(filename, format, width, height, error)
+            || !writer.writeRows(rgb, height, error)) {
+        return false;
+    }
+    return writer.close(error);
+}
@@ -0,0 +1,162 @@
+/********************************************************************************************
+* File: imagewriter.h
+* ----------------------
+* v.3 2026/10/17
+* - image files are raster sinks,
+* - memory-mapped image file
+* v.2 2026/10/17
+* - image is written by bands of rows, whole image is never kept in memory,
+* - BMP rows are top-down
+* v.1 2026/10/17
+* - binary PPM and 24-bit BMP files
+*
+* Image files without graphics back end.
+********************************************************************************************/
+
+#ifndef _imagewriter_h
+#define _imagewriter_h
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "rastersink.h"
+
+/* Type: ImageFormat
+ * -----------------
+ * IMAGE_PPM - binary "P6" portable pixmap,
+ * IMAGE_BMP - 24-bit uncompressed Windows bitmap, rows from the top
+ *   (negative height in header), file size is limited to 4 GB.  */
+enum ImageFormat {
+    IMAGE_PPM,
+    IMAGE_BMP
+};
+
+/* Function: imageFormatForFile
+ * ----------------------------
+ * Finds format by file name extension (".ppm", ".bmp", any case).
+ * Returns false if extension is unknown.  */
+bool imageFormatForFile(const std::string& filename, ImageFormat& format);
+
+/* Class: ImageStreamWriter
+ * ------------------------
+ * Writes image file row by row, from the top: header is written
+ * by open(), then rows are written in bands as soon as they are
+ * ready. Only one row of file bytes is kept in memory.
+ * As RasterSink, it accepts only whole rows, next after the
+ * rows which were written before.  */
+class ImageStreamWriter : public RasterSink {
+public:
+    ImageStreamWriter();
+
+    /* Destructor: ~ImageStreamWriter
+     * ------------------------------
+     * Closes file, if close() wasn't called.  */
+    ~ImageStreamWriter();
+
+    /* Method: open
+     * ------------
+     * Creates file and writes header of width x height image.
+     * Returns false and sets error if file can't be written.  */
+    bool open(const std::string& filename,
+              ImageFormat format,
+              int width,
+              int height,
+              std::string& error);
+
+    /* Method: writeRows
+     * -----------------
+     * Writes rowCount next rows. Pixel colors are 0xRRGGBB
+     * values rgb[row * width + col], as GBufferedImage has.  */
+    bool writeRows(const int* rgb, int rowCount, std::string& error);
+
+    bool writeRect(int x, int y, int width, int height,
+                   const int* rgb, std::string& error);
+
+    /* Method: close
+     * -------------
+     * Closes file, returns false if not all rows were written
+     * or file can't be written.  */
+    bool close(std::string& error);
+
+private:
+    FILE* file;
+    std::string filename;
+    ImageFormat format;
+    int width;
+    int height;
+    int rowsWritten;
+    std::vector<unsigned char> bytes;   /* One row of the file */
+
+    /* Writer can't be copied */
+    ImageStreamWriter(const ImageStreamWriter&);
+    ImageStreamWriter& operator=(const ImageStreamWriter&);
+};
+
+/* Class: MappedImageFile
+ * -----------------------
+ * Image file mapped into memory: open() creates file of full
+ * size with its header, and rectangles are converted straight
+ * into file pages, in any order. Operating system writes pages
+ * to disk in background, and image needs no memory of its own.
+ * Rectangles which don't overlap can be written by many threads
+ * at once.  */
+class MappedImageFile : public RasterSink {
+public:
+    MappedImageFile();
+
+    /* Destructor: ~MappedImageFile
+     * ----------------------------
+     * Unmaps and closes file, if close() wasn't called.  */
+    ~MappedImageFile();
+
+    /* Method: open
+     * ------------
+     * Creates file of width x height image and maps it into memory.
+     * Returns false and sets error if file can't be created.  */
+    bool open(const std::string& filename,
+              ImageFormat format,
+              int width,
+              int height,
+              std::string& error);
+
+    bool writeRect(int x, int y, int width, int height,
+                   const int* rgb, std::string& error);
+
+    /* Method: close
+     * -------------
+     * Unmaps file, returns false if it can't be written.  */
+    bool close(std::string& error);
+
+private:
+    std::string filename;
+    ImageFormat format;
+    int width;
+    int height;
+    long long rowSize;          /* Bytes of one row in file */
+    long long headerSize;
+    long long fileSize;
+    unsigned char* pixels;      /* Mapped file, NULL if it isn't open */
+#ifdef _WIN32
+    void* file;                 /* Windows handles */
+    void* mapping;
+#else
+    int file;                   /* File descriptor */
+#endif
+
+    /* File can't be copied */
+    MappedImageFile(const MappedImageFile&);
+    MappedImageFile& operator=(const MappedImageFile&);
+};
+
+/* Function: writeImage
+ * --------------------
+ * Writes width x height image to file at once.
+ * Returns false and sets error if file can't be written.  */
+bool writeImage(const std::string& filename,
+                ImageFormat format,
+                int width,
+                int height,
+                const int* rgb,
+                std::string& error);
+
+#endif
@@ -0,0 +1,806 @@
+/********************************************************************************************
+* File: mandelbrotkernel.cpp
+* ----------------------
+* v.1 2026/10/17
+* - iterative scalar kernel,
+* - SSE2/AVX2 strip kernels with runtime instruction set selection,
+* - closed-form test for main cardioide and period-2 bulb,
+* - optional Brent cycle detection for interior points,
+* - double-double precision kernels for mid-depth zooms,
+* - Multibrot, Burning Ship and Julia formulas as instantiations of one kernel
+*
+* Implementation of the mandelbrotkernel.h interface.
+********************************************************************************************/
+
+#include "mandelbrotkernel.h"
+#include <algorithm>
+#include <cmath>
+
+/* Vector kernels are built with GCC/Clang vector extensions on x86 CPUs,
+ * other compilers and CPUs use scalar kernel for every KernelIsa value. */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#  define MANDELBROT_VECTOR_KERNELS
+#endif
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+double const ESCAPE_RADIUS_SQUARED = 4;   /* |Z|^2 limit: Z leaves circle with radius "2" */
+double const DEFAULT_PERIODICITY_TOLERANCE = 1e-13; /* Z-values closer than that are equal */
+int const FIRST_PERIOD_CHECK = 1;         /* Z-value is saved at 1, 2, 4, 8... iterations */
+double const DOUBLE_SPACING_LIMIT = 1e-13;  /* Smaller spacing of pixels, relative to their
+                                             * coordinates, needs double-double precision */
+double const DEFAULT_JULIA_RE = -0.8;     /* Julia constant k of a connected dendrite-like set */
+double const DEFAULT_JULIA_IM = 0.156;
+
+/*------------------------------------------------------------------------------------------//
+ * Implementation section.
+ * -----------------------
+ * The main apreciation parameter is Z value,
+ * which forms sequences like this:
+ * Z0 = 0
+ * Znext = Zpreviuos^2 + c
+ *
+ * If (Z^2 < 4) for every iteration - this c-point belongs
+ * to Mandelbrot set. If we limit iterations quantity by maxDepth,
+ * and if for every iteration this apreciation will be true
+ * we can finish sequences for this c-point. This c-point is from
+ * Mandelbrot set then - it will be black on the picture.
+ *
+ * Vector kernels make the same operations, in the same order,
+ * as the scalar one, for a strip of c-points at once. Every lane
+ * is masked when its c-point escapes, and strip is finished
+ * when all lanes are masked. So iterations quantities are
+ * bit-identical for all instruction sets.
+ *
+ * Periodicity check (Brent's algorithm): Z-value is saved, and
+ * every next Z-value is compared with saved one. After period
+ * of checks, which doubles every time, new Z-value is saved.
+ * Orbit with any cycle length is found in at most 2 times more
+ * steps than cycle needs to start. Every lane has its own saved
+ * Z-value, but all lanes make steps together, so the check period
+ * is common for whole strip.
+ *
+ * Double-double kernels are the same templates with DoubleDouble
+ * numbers (or vectors of them) instead of double.
+ *
+ * Formula of step is template parameter F of every kernel (see
+ * Formula below), so each FractalFormula is compiled into its own
+ * loops with the step fully inlined. Runtime choice is made once
+ * per call of calculateMandelbrotPoints, by FORMULAS table.
+ * -----------------------------------------------------------------------------------------*/
+
+KernelOptions::KernelOptions()
+        : isa(detectKernelIsa()),
+          periodicityCheck(false),
+          periodicityTolerance(DEFAULT_PERIODICITY_TOLERANCE),
+          formula(FORMULA_MANDELBROT),
+          juliaRe(DEFAULT_JULIA_RE),
+          juliaIm(DEFAULT_JULIA_IM) {
+}
+
+/* Function: makeTwice
+ * -------------------
+ * x = 2 * x for double or vector of doubles (every lane).
+ * Kernel helpers change their arguments: functions which return
+ * AVX vectors would change ABI of the code without AVX.  */
+template <typename T>
+static inline __attribute__((always_inline))
+void makeTwice(T& x) {
+    x = 2 * x;
+}
+
+/* Function: makeTwice
+ * -------------------
+ * x = 2 * x for double-double, see twice.  */
+template <typename T>
+static inline __attribute__((always_inline))
+void makeTwice(DoubleDoubleOf<T>& x) {
+    x = twice(x);
+}
+
+/* Function: makeAbsolute
+ * ----------------------
+ * x = |x| for double or vector of doubles (every lane).  */
+template <typename T>
+static inline __attribute__((always_inline))
+void makeAbsolute(T& x) {
+    x = (x < 0) ? -x : x;
+}
+
+/* Function: makeAbsolute
+ * ----------------------
+ * x = |x| for double-double: its sign is the sign of hi.  */
+template <typename T>
+static inline __attribute__((always_inline))
+void makeAbsolute(DoubleDoubleOf<T>& x) {
+    x.lo = (x.hi < 0) ? -x.lo : x.lo;
+    x.hi = (x.hi < 0) ? -x.hi : x.hi;
+}
+
+/* Type: ComplexPower
+ * ------------------
+ * P = Z^POWER for POWER >= 2, by POWER - 1 complex multiplications.
+ * Square is made by the same operations as the original
+ * Mandelbrot kernel: (zR^2 - zI^2) + j(2 * zR * zI).  */
+template <int POWER>
+struct ComplexPower {
+    template <typename T>
+    static inline __attribute__((always_inline))
+    void raise(const T& zR, const T& zI, T& pR, T& pI) {
+        T qR;
+        T qI;
+        ComplexPower<POWER - 1>::raise(zR, zI, qR, qI);
+        pR = (qR * zR) - (qI * zI);
+        pI = (qR * zI) + (qI * zR);
+    }
+};
+
+template <>
+struct ComplexPower<2> {
+    template <typename T>
+    static inline __attribute__((always_inline))
+    void raise(const T& zR, const T& zI, T& pR, T& pI) {
+        pR = zR;
+        makeTwice(pR);
+        pI = pR * zI;
+        pR = (zR * zR) - (zI * zI);
+    }
+};
+
+/* Type: IterationKind
+ * -------------------
+ * What is raised to power at every step.  */
+enum IterationKind {
+    ITERATION_POWER,            /* Z itself */
+    ITERATION_BURNING_SHIP      /* |Re Z| + j|Im Z| */
+};
+
+/* Type: Formula
+ * -------------
+ * Step Znext = (Z or folded Z)^POWER + k of kernels.
+ * Mandelbrot-like formulas (JULIA = false) start from Z0 = 0
+ * with k = c, Julia formulas - from Z0 = c with constant k.  */
+template <IterationKind KIND, int POWER, bool JULIA>
+struct Formula {
+    static bool const IS_JULIA = JULIA;
+
+    template <typename T>
+    static inline __attribute__((always_inline))
+    void iterate(T& zR, T& zI, const T& kR, const T& kI) {
+        if (KIND == ITERATION_BURNING_SHIP) {
+            makeAbsolute(zR);
+            makeAbsolute(zI);
+        }
+        T pR;
+        T pI;
+        ComplexPower<POWER>::raise(zR, zI, pR, pI);
+        zI = pI + kI;
+        zR = pR + kR;
+    }
+};
+
+typedef Formula<ITERATION_POWER, 2, false> MandelbrotFormula;
+typedef Formula<ITERATION_POWER, 3, false> Multibrot3Formula;
+typedef Formula<ITERATION_POWER, 4, false> Multibrot4Formula;
+typedef Formula<ITERATION_BURNING_SHIP, 2, false> BurningShipFormula;
+typedef Formula<ITERATION_POWER, 2, true> JuliaFormula;
+typedef Formula<ITERATION_POWER, 3, true> Julia3Formula;
+
+KernelPrecision choosePrecision(double step, double magnitude) {
+    if (step >= DOUBLE_SPACING_LIMIT * std::max(1.0, std::fabs(magnitude))) {
+        return PRECISION_DOUBLE;
+    }
+    return PRECISION_DOUBLE_DOUBLE;
+}
+
+/* Function: calculateFormulaEquation
+ * ------------------------------------
+ * Scalar kernel of formula F for c-point c = a + jb,
+ * Julia formulas use constant k = kR + jkI.  */
+template <class F, typename Real>
+static inline int calculateFormulaEquation(const Real& a,
+                                           const Real& b,
+                                           double kR,
+                                           double kI,
+                                           int maxDepth) {
+    Real zR(0);     /* Z = zR + jzI, Z0 = 0 */
+    Real zI(0);
+    Real cR(a);     /* Constant of the step */
+    Real cI(b);
+    if (F::IS_JULIA) {
+        zR = a;
+        zI = b;
+        cR = Real(kR);
+        cI = Real(kI);
+    }
+    Real zLength(0);
+    int iter = 0;
+    do {
+        F::iterate(zR, zI, cR, cI);
+        zLength = (zR * zR) + (zI * zI);
+        iter++;
+    } while ((zLength < ESCAPE_RADIUS_SQUARED) && (iter < maxDepth));
+    return iter;
+}
+
+template <typename Real>
+int calculateMandelbrotEquation(const Real& a, const Real& b, int maxDepth) {
+    return calculateFormulaEquation<MandelbrotFormula>(a, b, 0, 0, maxDepth);
+}
+
+template int calculateMandelbrotEquation<double>(const double& a, const double& b, int maxDepth);
+template int calculateMandelbrotEquation<DoubleDouble>(const DoubleDouble& a,
+                                                       const DoubleDouble& b,
+                                                       int maxDepth);
+
+/* Function: sumDepths
+ * -------------------
+ * Returns sum of count depths: iterations made for them
+ * by kernel without early exits.  */
+static long long sumDepths(const int* depths, int count) {
+    long long sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += depths[i];
+    }
+    return sum;
+}
+
+/* Function: calculateWithPeriodicity
+ * ----------------------------------
+ * Scalar kernel with Brent cycle detection, see
+ * implementation section above. Sets made to iterations
+ * really made, which is less than result for cycles.  */
+template <class F>
+static int calculateWithPeriodicity(double a,
+                                    double b,
+                                    int maxDepth,
+                                    const KernelOptions& options,
+                                    int& made) {
+    double tolerance = options.periodicityTolerance;
+    double zR = 0;
+    double zI = 0;
+    double cR = a;
+    double cI = b;
+    if (F::IS_JULIA) {
+        zR = a;
+        zI = b;
+        cR = options.juliaRe;
+        cI = options.juliaIm;
+    }
+    double savedR = zR; /* Z-value to compare with */
+    double savedI = zI;
+    int checkLimit = FIRST_PERIOD_CHECK;
+    int checkCounter = 0;
+    double zLength = 0;
+    int iter = 0;
+    do {
+        F::iterate(zR, zI, cR, cI);
+        zLength = (zR * zR) + (zI * zI);
+        iter++;
+
+        if (zLength < ESCAPE_RADIUS_SQUARED) {
+            if (std::fabs(zR - savedR) < tolerance && std::fabs(zI - savedI) < tolerance) {
+                made = iter;
+                return maxDepth;    /* Orbit is a cycle - interior point */
+            }
+            if (++checkCounter == checkLimit) {
+                checkCounter = 0;
+                checkLimit *= 2;
+                savedR = zR;
+                savedI = zI;
+            }
+        }
+    } while ((zLength < ESCAPE_RADIUS_SQUARED) && (iter < maxDepth));
+    made = iter;
+    return iter;
+}
+
+bool isInsideCardioidOrBulb(double a, double b) {
+    /* Implementation notes
+     * --------------------------------------------------------------------
+     * Main cardioide: with q = (a - 1/4)^2 + b^2,
+     *   c-point is inside if q * (q + (a - 1/4)) <= b^2 / 4.
+     * Period-2 bulb: (a + 1)^2 + b^2 <= 1/16.
+     * --------------------------------------------------------------------*/
+    double bSquared = b * b;
+    double shiftedA = a - 0.25;
+    double q = (shiftedA * shiftedA) + bSquared;
+    if (q * (q + shiftedA) <= 0.25 * bSquared) {
+        return true;
+    }
+    double bulbA = a + 1;
+    return (bulbA * bulbA) + bSquared <= 0.0625;
+}
+
+#ifdef MANDELBROT_VECTOR_KERNELS
+
+/* Type: Lanes
+ * -----------
+ * Vector types of WIDTH doubles: Lanes<2> is one SSE2 register,
+ * Lanes<4> is one AVX register.  */
+template <int WIDTH>
+struct Lanes {
+    typedef double Real __attribute__((vector_size(WIDTH * sizeof(double))));
+    typedef long long Mask __attribute__((vector_size(WIDTH * sizeof(long long))));
+};
+
+/* Function: calculateStrip
+ * ------------------------
+ * Calculates 2 * WIDTH c-points (a[i] + jb[i]) at once by formula F.
+ * Two independent vectors are interleaved in every step,
+ * so they hide latency of each other's multiplications.
+ * PERIODIC adds cycle detection without any branches in the loop
+ * of kernel which doesn't use it.
+ * Returns iterations made by the first lanes c-points (the rest
+ * are padding).
+ * Forced inline lets caller with wider instruction set
+ * (see calculatePointsAvx2) compile it with its own registers. */
+template <class F, int WIDTH, bool PERIODIC>
+static inline __attribute__((always_inline))
+long long calculateStrip(const double* a,
+                         const double* b,
+                         int maxDepth,
+                         const KernelOptions& options,
+                         int* depths,
+                         int lanes) {
+    typedef typename Lanes<WIDTH>::Real Real;
+    typedef typename Lanes<WIDTH>::Mask Mask;
+
+    double tolerance = options.periodicityTolerance;
+    Real cR[2];             /* Constants of the step */
+    Real cI[2];
+    Real zR[2];
+    Real zI[2];
+    Real iter[2];           /* Iterations made by lanes */
+    Mask active[2];
+    Mask cycled[2];         /* Lanes stopped by cycle detection */
+    Real savedR[2];         /* Z-values to compare with */
+    Real savedI[2];
+    for (int v = 0; v < 2; v++) {
+        for (int i = 0; i < WIDTH; i++) {
+            cR[v][i] = a[v * WIDTH + i];
+            cI[v][i] = b[v * WIDTH + i];
+        }
+        zR[v] = cR[v] - cR[v];  /* Z0 = 0 */
+        zI[v] = zR[v];
+        iter[v] = zR[v];        /* Lane counters; exact up to 2^53 */
+        active[v] = (zR[v] == zR[v]);
+        cycled[v] = ~active[v];
+        if (F::IS_JULIA) {
+            zR[v] = cR[v];      /* Z0 = c, constant is k */
+            zI[v] = cI[v];
+            cR[v] = iter[v] + options.juliaRe;
+            cI[v] = iter[v] + options.juliaIm;
+        }
+        savedR[v] = zR[v];
+        savedI[v] = zI[v];
+    }
+    Real one = iter[0] + 1;
+    Real cycleDepth = iter[0] + maxDepth;
+    int checkLimit = FIRST_PERIOD_CHECK;
+    int checkCounter = 0;
+
+    for (int step = 0; step < maxDepth; step++) {
+        for (int v = 0; v < 2; v++) {
+            F::iterate(zR[v], zI[v], cR[v], cI[v]);
+            Real zLength = (zR[v] * zR[v]) + (zI[v] * zI[v]);
+            /* Only lanes which were active at this step count it */
+            iter[v] += (Real) ((Mask) one & active[v]);
+            active[v] &= (zLength < ESCAPE_RADIUS_SQUARED);
+
+            if (PERIODIC) {
+                Real dR = zR[v] - savedR[v];
+                Real dI = zI[v] - savedI[v];
+                Mask cycle = active[v]
+                        & (dR < tolerance) & (dR > -tolerance)
+                        & (dI < tolerance) & (dI > -tolerance);
+                /* Cycle lanes stop, their depth will be maxDepth */
+                cycled[v] |= cycle;
+                active[v] &= ~cycle;
+            }
+        }
+
+        if (PERIODIC && ++checkCounter == checkLimit) {
+            checkCounter = 0;
+            checkLimit *= 2;
+            savedR[0] = zR[0];
+            savedI[0] = zI[0];
+            savedR[1] = zR[1];
+            savedI[1] = zI[1];
+        }
+
+        Mask anyActive = active[0] | active[1];
+        bool finished = true;
+        for (int i = 0; i < WIDTH; i++) {
+            finished &= (anyActive[i] == 0);
+        }
+        if (finished) {
+            break;
+        }
+    }
+
+    long long made = 0;
+    for (int v = 0; v < 2; v++) {
+        Real depth = (Real) (((Mask) iter[v] & ~cycled[v]) | ((Mask) cycleDepth & cycled[v]));
+        for (int i = 0; i < WIDTH; i++) {
+            depths[v * WIDTH + i] = (int) depth[i];
+            if (v * WIDTH + i < lanes) {
+                made += (long long) iter[v][i];
+            }
+        }
+    }
+    return made;
+}
+
+/* Function: calculatePointsWith
+ * -----------------------------
+ * Splits c-points into strips of 2 * WIDTH. The last incomplete
+ * strip is padded by its last c-point. Returns iterations made.  */
+template <class F, int WIDTH, bool PERIODIC>
+static inline __attribute__((always_inline))
+long long calculatePointsWith(const double* a,
+                         const double* b,
+                         int count,
+                         int maxDepth,
+                         const KernelOptions& options,
+                         int* depths) {
+    int const STRIP = 2 * WIDTH;
+    long long made = 0;
+    int i = 0;
+    for (; i + STRIP <= count; i += STRIP) {
+        made += calculateStrip<F, WIDTH, PERIODIC>(a + i, b + i, maxDepth, options,
+                                                   depths + i, STRIP);
+    }
+    if (i < count) {
+        double tailA[STRIP];
+        double tailB[STRIP];
+        int tailDepths[STRIP];
+        for (int k = 0; k < STRIP; k++) {
+            int src = (i + k < count) ? (i + k) : (count - 1);
+            tailA[k] = a[src];
+            tailB[k] = b[src];
+        }
+        made += calculateStrip<F, WIDTH, PERIODIC>(tailA, tailB, maxDepth, options,
+                                                   tailDepths, count - i);
+        for (int k = 0; i + k < count; k++) {
+            depths[i + k] = tailDepths[k];
+        }
+    }
+    return made;
+}
+
+/* Function: calculateDoubleDoubleStrip
+ * -------------------------------------
+ * Calculates WIDTH double-double c-points at once. One vector
+ * is enough: long chains of double-double operations have
+ * many independent multiplications themselves.  */
+template <class F, int WIDTH>
+static inline __attribute__((always_inline))
+void calculateDoubleDoubleStrip(const DoubleDouble* a,
+                                const DoubleDouble* b,
+                                int maxDepth,
+                                const KernelOptions& options,
+                                int* depths) {
+    typedef typename Lanes<WIDTH>::Real Real;
+    typedef typename Lanes<WIDTH>::Mask Mask;
+    typedef DoubleDoubleOf<Real> Number;
+
+    Number cR;
+    Number cI;
+    for (int i = 0; i < WIDTH; i++) {
+        cR.hi[i] = a[i].hi;
+        cR.lo[i] = a[i].lo;
+        cI.hi[i] = b[i].hi;
+        cI.lo[i] = b[i].lo;
+    }
+    Number zR;              /* Z0 = 0 */
+    Number zI;
+    Real iter = zR.hi;
+    Mask active = (iter == iter);
+    Real one = iter + 1;
+    if (F::IS_JULIA) {
+        zR = cR;            /* Z0 = c, constant is k */
+        zI = cI;
+        cR = Number(iter + options.juliaRe);
+        cI = Number(iter + options.juliaIm);
+    }
+
+    for (int step = 0; step < maxDepth; step++) {
+        F::iterate(zR, zI, cR, cI);
+        Number zLength = (zR * zR) + (zI * zI);
+        iter += (Real) ((Mask) one & active);
+        /* The same comparison as DoubleDouble operator< makes */
+        active &= (zLength.hi < ESCAPE_RADIUS_SQUARED)
+                | ((zLength.hi == ESCAPE_RADIUS_SQUARED) & (zLength.lo < 0));
+
+        bool finished = true;
+        for (int i = 0; i < WIDTH; i++) {
+            finished &= (active[i] == 0);
+        }
+        if (finished) {
+            break;
+        }
+    }
+
+    for (int i = 0; i < WIDTH; i++) {
+        depths[i] = (int) iter[i];
+    }
+}
+
+/* Function: calculateDoubleDoublePointsWith
+ * -----------------------------------------
+ * Splits double-double c-points into strips of WIDTH,
+ * as calculatePointsWith does.  */
+template <class F, int WIDTH>
+static inline __attribute__((always_inline))
+long long calculateDoubleDoublePointsWith(const DoubleDouble* a,
+                                     const DoubleDouble* b,
+                                     int count,
+                                     int maxDepth,
+                                     const KernelOptions& options,
+                                     int* depths) {
+    int i = 0;
+    for (; i + WIDTH <= count; i += WIDTH) {
+        calculateDoubleDoubleStrip<F, WIDTH>(a + i, b + i, maxDepth, options, depths + i);
+    }
+    if (i < count) {
+        DoubleDouble tailA[WIDTH];
+        DoubleDouble tailB[WIDTH];
+        int tailDepths[WIDTH];
+        for (int k = 0; k < WIDTH; k++) {
+            int src = (i + k < count) ? (i + k) : (count - 1);
+            tailA[k] = a[src];
+            tailB[k] = b[src];
+        }
+        calculateDoubleDoubleStrip<F, WIDTH>(tailA, tailB, maxDepth, options, tailDepths);
+        for (int k = 0; i + k < count; k++) {
+            depths[i + k] = tailDepths[k];
+        }
+    }
+    return sumDepths(depths, count);  /* No early exits */
+}
+
+template <class F>
+static long long calculatePointsSse2(const double* a,
+                                const double* b,
+                                int count,
+                                int maxDepth,
+                                int* depths,
+                                const KernelOptions& options) {
+    if (options.periodicityCheck) {
+        return calculatePointsWith<F, 2, true>(a, b, count, maxDepth, options, depths);
+    } else {
+        return calculatePointsWith<F, 2, false>(a, b, count, maxDepth, options, depths);
+    }
+}
+
+template <class F>
+__attribute__((target("avx2")))
+static long long calculatePointsAvx2(const double* a,
+                                const double* b,
+                                int count,
+                                int maxDepth,
+                                int* depths,
+                                const KernelOptions& options) {
+    if (options.periodicityCheck) {
+        return calculatePointsWith<F, 4, true>(a, b, count, maxDepth, options, depths);
+    } else {
+        return calculatePointsWith<F, 4, false>(a, b, count, maxDepth, options, depths);
+    }
+}
+
+template <class F>
+static long long calculateDoubleDoublePointsSse2(const DoubleDouble* a,
+                                            const DoubleDouble* b,
+                                            int count,
+                                            int maxDepth,
+                                            int* depths,
+                                            const KernelOptions& options) {
+    return calculateDoubleDoublePointsWith<F, 2>(a, b, count, maxDepth, options, depths);
+}
+
+template <class F>
+__attribute__((target("avx2")))
+static long long calculateDoubleDoublePointsAvx2(const DoubleDouble* a,
+                                            const DoubleDouble* b,
+                                            int count,
+                                            int maxDepth,
+                                            int* depths,
+                                            const KernelOptions& options) {
+    return calculateDoubleDoublePointsWith<F, 4>(a, b, count, maxDepth, options, depths);
+}
+
+#endif // MANDELBROT_VECTOR_KERNELS
+
+/* Function: calculateFormulaPoints
+ * --------------------------------
+ * calculateMandelbrotPoints for formula F.  */
+template <class F>
+static long long calculateFormulaPoints(const double* a,
+                                   const double* b,
+                                   int count,
+                                   int maxDepth,
+                                   int* depths,
+                                   const KernelOptions& options) {
+#ifdef MANDELBROT_VECTOR_KERNELS
+    switch (options.isa) {
+    case KERNEL_AVX2:
+        return calculatePointsAvx2<F>(a, b, count, maxDepth, depths, options);
+    case KERNEL_SSE2:
+        return calculatePointsSse2<F>(a, b, count, maxDepth, depths, options);
+    default:
+        break;
+    }
+#endif
+    long long made = 0;
+    for (int i = 0; i < count; i++) {
+        if (options.periodicityCheck) {
+            int pointMade = 0;
+            depths[i] = calculateWithPeriodicity<F>(a[i], b[i], maxDepth, options, pointMade);
+            made += pointMade;
+        } else {
+            depths[i] = calculateFormulaEquation<F>(a[i], b[i], options.juliaRe,
+                                                    options.juliaIm, maxDepth);
+            made += depths[i];
+        }
+    }
+    return made;
+}
+
+/* Function: calculateFormulaPoints
+ * --------------------------------
+ * The same for double-double c-points.  */
+template <class F>
+static long long calculateFormulaPoints(const DoubleDouble* a,
+                                   const DoubleDouble* b,
+                                   int count,
+                                   int maxDepth,
+                                   int* depths,
+                                   const KernelOptions& options) {
+#ifdef MANDELBROT_VECTOR_KERNELS
+    switch (options.isa) {
+    case KERNEL_AVX2:
+        return calculateDoubleDoublePointsAvx2<F>(a, b, count, maxDepth, depths, options);
+    case KERNEL_SSE2:
+        return calculateDoubleDoublePointsSse2<F>(a, b, count, maxDepth, depths, options);
+    default:
+        break;
+    }
+#endif
+    for (int i = 0; i < count; i++) {
+        depths[i] = calculateFormulaEquation<F>(a[i], b[i], options.juliaRe,
+                                                options.juliaIm, maxDepth);
+    }
+    return sumDepths(depths, count);
+}
+
+/* Type: FormulaEntry
+ * ------------------
+ * Row of formulas dispatch table: name and kernels of
+ * one formula instantiation.  */
+struct FormulaEntry {
+    const char* name;
+    long long (*points)(const double* a, const double* b, int count, int maxDepth,
+                        int* depths, const KernelOptions& options);
+    long long (*exactPoints)(const DoubleDouble* a, const DoubleDouble* b, int count,
+                             int maxDepth, int* depths, const KernelOptions& options);
+};
+
+/* Formulas in the order of FractalFormula values */
+static FormulaEntry const FORMULAS[FORMULA_COUNT] = {
+    {"mandelbrot", calculateFormulaPoints<MandelbrotFormula>,
+                   calculateFormulaPoints<MandelbrotFormula>},
+    {"multibrot3", calculateFormulaPoints<Multibrot3Formula>,
+                   calculateFormulaPoints<Multibrot3Formula>},
+    {"multibrot4", calculateFormulaPoints<Multibrot4Formula>,
+                   calculateFormulaPoints<Multibrot4Formula>},
+    {"burning-ship", calculateFormulaPoints<BurningShipFormula>,
+                     calculateFormulaPoints<BurningShipFormula>},
+    {"julia", calculateFormulaPoints<JuliaFormula>,
+              calculateFormulaPoints<JuliaFormula>},
+    {"julia3", calculateFormulaPoints<Julia3Formula>,
+               calculateFormulaPoints<Julia3Formula>}
+};
+
+/* Function: findFormula
+ * ---------------------
+ * Returns dispatch table row of formula, unknown values
+ * get FORMULA_MANDELBROT row.  */
+static const FormulaEntry& findFormula(FractalFormula formula) {
+    if (formula < 0 || formula >= FORMULA_COUNT) {
+        formula = FORMULA_MANDELBROT;
+    }
+    return FORMULAS[formula];
+}
+
+/* Function: validDepth
+ * --------------------
+ * Returns maxDepth, but not less than 1: scalar kernel makes at
+ * least one step, so vector kernels must get at least one too.  */
+static inline int validDepth(int maxDepth) {
+    return std::max(maxDepth, 1);
+}
+
+long long calculateMandelbrotPoints(const double* a,
+                                    const double* b,
+                                    int count,
+                                    int maxDepth,
+                                    int* depths,
+                                    const KernelOptions& options) {
+    return findFormula(options.formula).points(a, b, count, validDepth(maxDepth), depths, options);
+}
+
+long long calculateMandelbrotPoints(const DoubleDouble* a,
+                                    const DoubleDouble* b,
+                                    int count,
+                                    int maxDepth,
+                                    int* depths,
+                                    const KernelOptions& options) {
+    return findFormula(options.formula).exactPoints(a, b, count, validDepth(maxDepth), depths,
+                                                    options);
+}
+
+bool formulaForName(const std::string& name, FractalFormula& formula) {
+    for (int i = 0; i < FORMULA_COUNT; i++) {
+        if (name == FORMULAS[i].name) {
+            formula = (FractalFormula) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* formulaName(FractalFormula formula) {
+    return findFormula(formula).name;
+}
+
+bool hasCardioidTest(FractalFormula formula) {
+    return formula == FORMULA_MANDELBROT;
+}
+
+bool isConjugateSymmetric(const KernelOptions& options) {
+    switch (options.formula) {
+    case FORMULA_MANDELBROT:
+    case FORMULA_MULTIBROT_3:
+    case FORMULA_MULTIBROT_4:
+        return true;
+    case FORMULA_JULIA:
+    case FORMULA_JULIA_3:
+        return options.juliaIm == 0;
+    default:
+        return false;
+    }
+}
+
+KernelIsa detectKernelIsa() {
+#ifdef MANDELBROT_VECTOR_KERNELS
+    static KernelIsa const detected =
+            __builtin_cpu_supports("avx2") ? KERNEL_AVX2 : KERNEL_SSE2;
+    return detected;
+#else
+    return KERNEL_SCALAR;
+#endif
+}
+
+const char* kernelIsaName(KernelIsa isa) {
+    switch (isa) {
+    case KERNEL_AVX2:
+        return "avx2";
+    case KERNEL_SSE2:
+        return "sse2";
+    default:
+        return "scalar";
+    }
+}
+
+const char* kernelPrecisionName(KernelPrecision precision) {
+    switch (precision) {
+    case PRECISION_DOUBLE:
+        return "double";
+    case PRECISION_DOUBLE_DOUBLE:
+        return "double-double";
+    default:
+        return "auto";
+    }
+}
@@ -0,0 +1,212 @@
+/********************************************************************************************
+* File: mandelbrotkernel.h
+* ----------------------
+* v.1 2026/10/17
+* - iterative scalar kernel,
+* - SSE2/AVX2 strip kernels with runtime instruction set selection,
+* - closed-form test for main cardioide and period-2 bulb,
+* - optional Brent cycle detection for interior points,
+* - double-double precision kernels for mid-depth zooms,
+* - Multibrot, Burning Ship and Julia formulas as instantiations of one kernel
+*
+* Escape-time kernel of the Mandelbrot set drawing.
+********************************************************************************************/
+
+#ifndef _mandelbrotkernel_h
+#define _mandelbrotkernel_h
+
+#include <string>
+#include "doubledouble.h"
+
+/* Type: KernelIsa
+ * ---------------
+ * Instruction set used by calculateMandelbrotPoints.
+ * KERNEL_SSE2 advances 4 c-points per step (two 2-lane vectors),
+ * KERNEL_AVX2 advances 8 c-points per step (two 4-lane vectors).  */
+enum KernelIsa {
+    KERNEL_SCALAR,
+    KERNEL_SSE2,
+    KERNEL_AVX2
+};
+
+/* Type: KernelPrecision
+ * ---------------------
+ * Precision of c-points and Z-values.
+ * PRECISION_DOUBLE resolves pixels down to spacing of about 1e-13,
+ * PRECISION_DOUBLE_DOUBLE (about 106 bits, see doubledouble.h) -
+ * down to about 1e-28, and is about 10 times slower. Deeper zooms
+ * need perturbation (see deepzoom.h).
+ * PRECISION_AUTO lets renderer call choosePrecision for its frame.  */
+enum KernelPrecision {
+    PRECISION_AUTO,
+    PRECISION_DOUBLE,
+    PRECISION_DOUBLE_DOUBLE
+};
+
+/* Type: FractalFormula
+ * ---------------------
+ * Iteration formula of kernel. Mandelbrot-like formulas start
+ * from Z0 = 0 and add c-point c of pixel at every step:
+ * FORMULA_MANDELBROT    Znext = Z^2 + c,
+ * FORMULA_MULTIBROT_3   Znext = Z^3 + c,
+ * FORMULA_MULTIBROT_4   Znext = Z^4 + c,
+ * FORMULA_BURNING_SHIP  Znext = (|Re Z| + j|Im Z|)^2 + c.
+ * Julia formulas start from Z0 = c and add constant
+ * k = juliaRe + j juliaIm of KernelOptions:
+ * FORMULA_JULIA         Znext = Z^2 + k,
+ * FORMULA_JULIA_3       Znext = Z^3 + k.
+ * Every formula is a separate instantiation of the kernel templates,
+ * so its step has no branches. See formulaForName for their names.  */
+enum FractalFormula {
+    FORMULA_MANDELBROT,
+    FORMULA_MULTIBROT_3,
+    FORMULA_MULTIBROT_4,
+    FORMULA_BURNING_SHIP,
+    FORMULA_JULIA,
+    FORMULA_JULIA_3,
+    FORMULA_COUNT
+};
+
+/* Type: KernelOptions
+ * -------------------
+ * Variant of kernel used by calculateMandelbrotPoints.
+ *
+ * periodicityCheck enables Brent cycle detection: Z-value is saved
+ * at iterations 1, 2, 4, 8, ... and when next Z-values come back
+ * to the saved one (both parts closer than periodicityTolerance),
+ * orbit is a cycle and c-point is reported as interior (maxDepth)
+ * at once. It costs a few operations per step, and pays back
+ * where interior points are not caught by isInsideCardioidOrBulb -
+ * minibrots and higher-period bulbs, especially with big maxDepth.
+ * Only double precision kernels make this check: double-double
+ * kernels ignore periodicityCheck, because default tolerance is far
+ * bigger than pixel spacing of their zooms and would take border
+ * points for interior ones. Callers report such combination.
+ *
+ * formula is FORMULA_MANDELBROT by default, juliaRe and juliaIm
+ * are used by Julia formulas only.  */
+struct KernelOptions {
+    KernelIsa isa;
+    bool periodicityCheck;
+    double periodicityTolerance;
+    FractalFormula formula;
+    double juliaRe;
+    double juliaIm;
+
+    KernelOptions();
+};
+
+/* Function: detectKernelIsa
+ * -------------------------
+ * Returns the widest instruction set supported by current CPU.
+ * Detection is made once, at the first call.  */
+KernelIsa detectKernelIsa();
+
+/* Function: choosePrecision
+ * -------------------------
+ * Returns the cheapest precision, which resolves neighbour
+ * pixels with distance step between them near c-points
+ * with real and imaginary values up to magnitude.
+ *
+ * @param step       Complex distance between neighbour pixels
+ * @param magnitude  The biggest absolute value of c-points coordinates  */
+KernelPrecision choosePrecision(double step, double magnitude);
+
+/* Function: calculateMandelbrotEquation
+ * --------------------------------------
+ * Returns iterations quantity for c-point c = a + jb.
+ * Result is in range [1, maxDepth], maxDepth means that
+ * c-point is treated as Mandelbrot set point.
+ * Real is double or DoubleDouble.
+ *
+ * @param a, b       Complex area c-point: c = a + jb
+ * @param maxDepth   Limit for iterations quantity  */
+template <typename Real>
+int calculateMandelbrotEquation(const Real& a, const Real& b, int maxDepth);
+
+/* Function: isInsideCardioidOrBulb
+ * ---------------------------------
+ * Returns true if c-point c = a + jb lies inside the main
+ * cardioide or inside the period-2 bulb (circle with centre "-1"
+ * and radius "1/4"). Such points never escape, so their
+ * iterations quantity is maxDepth without any iterations.
+ *
+ * @param a, b       Complex area c-point: c = a + jb  */
+bool isInsideCardioidOrBulb(double a, double b);
+
+/* Function: calculateMandelbrotPoints
+ * -----------------------------------
+ * Fills depths[i] with iterations quantity for c-points
+ * a[i] + jb[i], i = 0 ... count - 1, by formula of options.
+ * Every instruction set gives exactly the same values as
+ * the scalar kernel does for each point; for FORMULA_MANDELBROT
+ * they are the values of calculateMandelbrotEquation.
+ * Periodicity check reports interior points earlier. With too
+ * big tolerance it can also take slowly escaping point near the
+ * set border for interior one, so it is off by default.
+ * Returns iterations really made for all c-points: it is the sum
+ * of depths, less the steps skipped by periodicity check.
+ *
+ * @param a, b       Arrays of c-points real and imaginary values
+ * @param count      Quantity of c-points
+ * @param maxDepth   Limit for iterations quantity, values below 1
+ *                   are taken as 1 for every instruction set
+ * @param depths     Output array for iterations quantities
+ * @param options    Kernel variant, by default - the best instruction set
+ *                   of this CPU without periodicity check  */
+long long calculateMandelbrotPoints(const double* a,
+                                    const double* b,
+                                    int count,
+                                    int maxDepth,
+                                    int* depths,
+                                    const KernelOptions& options = KernelOptions());
+
+/* Function: calculateMandelbrotPoints
+ * -----------------------------------
+ * The same for c-points with double-double precision.
+ * Periodicity check is not made: its tolerance is far
+ * bigger than pixel spacing of such zooms.  */
+long long calculateMandelbrotPoints(const DoubleDouble* a,
+                                    const DoubleDouble* b,
+                                    int count,
+                                    int maxDepth,
+                                    int* depths,
+                                    const KernelOptions& options = KernelOptions());
+
+/* Function: formulaForName
+ * -------------------------
+ * Sets formula by its name: "mandelbrot", "multibrot3", "multibrot4",
+ * "burning-ship", "julia" or "julia3". Returns false if there is
+ * no formula with such name.  */
+bool formulaForName(const std::string& name, FractalFormula& formula);
+
+/* Function: formulaName
+ * ---------------------
+ * Returns name of formula, see formulaForName.  */
+const char* formulaName(FractalFormula formula);
+
+/* Function: hasCardioidTest
+ * -------------------------
+ * Returns true if isInsideCardioidOrBulb finds interior points of
+ * formula: it is so only for FORMULA_MANDELBROT.  */
+bool hasCardioidTest(FractalFormula formula);
+
+/* Function: isConjugateSymmetric
+ * ------------------------------
+ * Returns true if c-points a + jb and a - jb have the same depth
+ * with these options. It is so for Mandelbrot and Multibrot formulas,
+ * and for Julia formulas with real constant k; Burning Ship folds
+ * Z-values into one quadrant and isn't symmetric.  */
+bool isConjugateSymmetric(const KernelOptions& options);
+
+/* Function: kernelIsaName
+ * -----------------------
+ * Returns printable name of instruction set: "scalar", "sse2", "avx2".  */
+const char* kernelIsaName(KernelIsa isa);
+
+/* Function: kernelPrecisionName
+ * -----------------------------
+ * Returns printable name of precision: "auto", "double", "double-double".  */
+const char* kernelPrecisionName(KernelPrecision precision);
+
+#endif
@@ -0,0 +1,35 @@
+/********************************************************************************************
+* File: palette.cpp
+* ----------------------
+* v.1 2026/10/17
+* - colors of iterations quantities are taken from lookup table,
+* - default palette table is generated at compile time
+*
+* Implementation of the palette.h interface.
+********************************************************************************************/
+
+#include "palette.h"
+
+Palette::Palette(const int* colors, int maxDepth)
+        : colors(colors, colors + maxDepth + 1) {
+}
+
+Palette Palette::makeDefault(int maxDepth) {
+    std::vector<int> colors(maxDepth + 1);
+    for (int depth = 0; depth <= maxDepth; depth++) {
+        colors[depth] = defaultPaletteColor(depth, maxDepth);
+    }
+    return Palette(&colors[0], maxDepth);
+}
+
+int Palette::getMaxDepth() const {
+    return (int) colors.size() - 1;
+}
+
+void Palette::colorize(const int* depths, int count, int* rgb) const {
+    const int* table = &colors[0];
+    int maxDepth = (int) colors.size() - 1;
+    for (int i = 0; i < count; i++) {
+        rgb[i] = table[std::min(std::max(depths[i], 0), maxDepth)];
+    }
+}
@@ -0,0 +1,143 @@
+/********************************************************************************************
+* File: palette.h
+* ----------------------
+* v.1 2026/10/17
+* - colors of iterations quantities are taken from lookup table,
+* - default palette table is generated at compile time
+*
+* Colorization of iterations quantities, separate from their calculation.
+********************************************************************************************/
+
+#ifndef _palette_h
+#define _palette_h
+
+#include <algorithm>
+#include <vector>
+
+int const COLORS_RANGE = 255;   /* Possible range of colors values */
+
+/* Function: defaultPaletteLevel
+ * -----------------------------
+ * Returns distance of iterations quantity depth to maxDepth,
+ * scaled to COLORS_RANGE: 0 for maxDepth, COLORS_RANGE for 0.  */
+constexpr int defaultPaletteLevel(int depth, int maxDepth) {
+    return COLORS_RANGE * (maxDepth - depth) / maxDepth;
+}
+
+/* Function: defaultPaletteColor
+ * -----------------------------
+ * Returns color of pixel with iterations quantity depth:
+ * - if depth = maxDepth - it's black pixel,
+ * - if depth < maxDepth - color is cube of defaultPaletteLevel.  */
+constexpr int defaultPaletteColor(int depth, int maxDepth) {
+    return defaultPaletteLevel(depth, maxDepth)
+            * defaultPaletteLevel(depth, maxDepth)
+            * defaultPaletteLevel(depth, maxDepth);
+}
+
+/* Implementation notes
+ * --------------------------------------------------------------------
+ * C++11 has no std::index_sequence: IndexSequence<0, 1, ... N - 1>
+ * is made by joining two halves, so template nesting depth is
+ * log2(N), not N. Then table is one brace list:
+ *   { defaultPaletteColor(0, M), defaultPaletteColor(1, M), ... }
+ * --------------------------------------------------------------------*/
+namespace palette {
+
+template <int... I>
+struct IndexSequence {
+};
+
+template <typename First, typename Second>
+struct JoinSequences;
+
+template <int... A, int... B>
+struct JoinSequences<IndexSequence<A...>, IndexSequence<B...> > {
+    typedef IndexSequence<A..., (int) sizeof...(A) + B...> type;
+};
+
+template <int N>
+struct MakeIndexSequence {
+    typedef typename JoinSequences<typename MakeIndexSequence<N / 2>::type,
+                                   typename MakeIndexSequence<N - N / 2>::type>::type type;
+};
+
+template <>
+struct MakeIndexSequence<0> {
+    typedef IndexSequence<> type;
+};
+
+template <>
+struct MakeIndexSequence<1> {
+    typedef IndexSequence<0> type;
+};
+
+} // namespace palette
+
+/* Type: ColorTable
+ * ----------------
+ * Colors of iterations quantities 0 ... SIZE - 1.  */
+template <int SIZE>
+struct ColorTable {
+    int colors[SIZE];
+};
+
+template <int MAX_DEPTH, int... I>
+constexpr ColorTable<sizeof...(I)> makeDefaultColorTable(palette::IndexSequence<I...>) {
+    return {{ defaultPaletteColor(I, MAX_DEPTH)... }};
+}
+
+/* Type: DefaultPalette
+ * --------------------
+ * DefaultPalette<MAX_DEPTH>::table is the lookup table of
+ * defaultPaletteColor, calculated by compiler.  */
+template <int MAX_DEPTH>
+struct DefaultPalette {
+    static constexpr ColorTable<MAX_DEPTH + 1> table =
+            makeDefaultColorTable<MAX_DEPTH>(
+                    typename palette::MakeIndexSequence<MAX_DEPTH + 1>::type());
+};
+
+template <int MAX_DEPTH>
+constexpr ColorTable<MAX_DEPTH + 1> DefaultPalette<MAX_DEPTH>::table;
+
+/* Class: Palette
+ * --------------
+ * Lookup table of colors for iterations quantities 0 ... maxDepth.
+ * Image is colorized by one table lookup per pixel, so coloring
+ * can be changed without any recalculation of iterations.  */
+class Palette {
+public:
+    /* Constructor: Palette
+     * --------------------
+     * Copies table colors[0 ... maxDepth].  */
+    Palette(const int* colors, int maxDepth);
+
+    /* Function: makeDefault
+     * ---------------------
+     * Returns default palette for maxDepth, which is known at run
+     * time only. Known maxDepth can use DefaultPalette table:
+     *   Palette(DefaultPalette<MAX_DEPTH>::table.colors, MAX_DEPTH).  */
+    static Palette makeDefault(int maxDepth);
+
+    int getMaxDepth() const;
+
+    /* Method: getColor
+     * ----------------
+     * Returns color of depth; depths out of 0 ... maxDepth get the
+     * color of the nearest end, e.g. deepened pixels - of maxDepth.  */
+    int getColor(int depth) const {
+        return colors[std::min(std::max(depth, 0), (int) colors.size() - 1)];
+    }
+
+    /* Method: colorize
+     * ----------------
+     * Fills rgb[i] with color of depths[i], i = 0 ... count - 1,
+     * out of range depths are clamped as by getColor.  */
+    void colorize(const int* depths, int count, int* rgb) const;
+
+private:
+    std::vector<int> colors;
+};
+
+#endif
@@ -0,0 +1,34 @@
+/********************************************************************************************
+* File: rastersink.h
+* ----------------------
+* v.1 2026/10/17
+* - interface of image outputs
+*
+* Destination of rendered pixel colors.
+********************************************************************************************/
+
+#ifndef _rastersink_h
+#define _rastersink_h
+
+#include <string>
+
+/* Class: RasterSink
+ * -----------------
+ * Output of image colors, for example image file. GUI program
+ * paints GBufferedImage instead; renders which don't need window
+ * write to a sink.  */
+class RasterSink {
+public:
+    virtual ~RasterSink() {}
+
+    /* Method: writeRect
+     * -----------------
+     * Writes width x height rectangle with top-left pixel (x, y).
+     * Pixel colors are 0xRRGGBB values rgb[row * width + col], as
+     * GBufferedImage has. Returns false and sets error if
+     * rectangle can't be written.  */
+    virtual bool writeRect(int x, int y, int width, int height,
+                           const int* rgb, std::string& error) = 0;
+};
+
+#endif
@@ -0,0 +1,113 @@
+/********************************************************************************************
+* File: tileprofile.cpp
+* ----------------------
+* v.1 2026/10/17
+* - per-tile render counters, JSON export and heatmap image
+*
+* Implementation of the tileprofile.h interface.
+********************************************************************************************/
+
+#include "tileprofile.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const HEATMAP_EMPTY_COLOR = 0x404040;   /* Pixels which no tile rendered */
+
+/* Function: getHeatColor
+ * ----------------------
+ * Returns color of heat in range [0, 1]: black -> blue -> red -> white.  */
+static int getHeatColor(double heat) {
+    int level = (int) (std::max(0.0, std::min(1.0, heat)) * 3 * 255 + 0.5);
+    if (level <= 255) {
+        return level;                                       /* Black to blue */
+    }
+    if (level <= 2 * 255) {
+        int red = level - 255;
+        return (red << 16) | (255 - red);                   /* Blue to red */
+    }
+    int light = level - 2 * 255;
+    return 0xff0000 | (light << 8) | light;                 /* Red to white */
+}
+
+bool writeRenderProfile(const std::string& filename,
+                        const RenderProfile& profile,
+                        std::string& error) {
+    std::ofstream file(filename.c_str());
+    file << std::setprecision(9);
+    file << "{" << std::endl
+         << "  \"width\": " << profile.width << "," << std::endl
+         << "  \"height\": " << profile.height << "," << std::endl
+         << "  \"threads\": " << profile.threads << "," << std::endl
+         << "  \"renderSeconds\": " << profile.renderSeconds << "," << std::endl
+         << "  \"writeWaitSeconds\": " << profile.writeWaitSeconds << "," << std::endl
+         << "  \"tiles\": [" << std::endl;
+    for (size_t i = 0; i < profile.tiles.size(); i++) {
+        const TileProfile& tile = profile.tiles[i];
+        file << "    {\"x\": " << tile.x << ", \"y\": " << tile.y
+             << ", \"width\": " << tile.width << ", \"height\": " << tile.height
+             << ", \"worker\": " << tile.worker
+             << ", \"queueSeconds\": " << tile.queueSeconds
+             << ", \"seconds\": " << tile.seconds
+             << ", \"iterations\": " << tile.iterations
+             << ", \"interiorPixels\": " << tile.interiorPixels
+             << ", \"escapedPixels\": " << tile.escapedPixels << "}"
+             << ((i + 1 < profile.tiles.size()) ? "," : "") << std::endl;
+    }
+    file << "  ]" << std::endl << "}" << std::endl;
+    if (!file) {
+        error = "can't write file \"" + filename + "\"";
+        return false;
+    }
+    return true;
+}
+
+/* Implementation notes: makeHeatmap
+ * --------------------------------------------------------------------
+ * Heatmap pixel (hx, hy) shows the tile which contains the frame
+ * pixel at the centre of its scale x scale square, or the last pixel
+ * of frame for squares cut by its edge. Heat is tile time per pixel,
+ * scaled from the fastest tile to the slowest one.
+ * --------------------------------------------------------------------*/
+void makeHeatmap(const RenderProfile& profile,
+                 int scale,
+                 int& width,
+                 int& height,
+                 std::vector<int>& rgb) {
+    scale = std::max(1, scale);
+    width = std::max(1, (profile.width + scale - 1) / scale);
+    height = std::max(1, (profile.height + scale - 1) / scale);
+    rgb.assign((size_t) width * height, HEATMAP_EMPTY_COLOR);
+
+    std::vector<double> timePerPixel(profile.tiles.size(), 0);
+    double fastest = 0;
+    double slowest = 0;
+    for (size_t i = 0; i < profile.tiles.size(); i++) {
+        const TileProfile& tile = profile.tiles[i];
+        timePerPixel[i] = tile.seconds / std::max(1, tile.width * tile.height);
+        fastest = (i == 0) ? timePerPixel[i] : std::min(fastest, timePerPixel[i]);
+        slowest = std::max(slowest, timePerPixel[i]);
+    }
+    double range = slowest - fastest;
+
+    int centre = scale / 2;
+    for (size_t i = 0; i < profile.tiles.size(); i++) {
+        const TileProfile& tile = profile.tiles[i];
+        int color = getHeatColor((range > 0) ? (timePerPixel[i] - fastest) / range : 0);
+        int firstRow = std::max(0, (tile.y - centre + scale - 1) / scale);
+        int firstCol = std::max(0, (tile.x - centre + scale - 1) / scale);
+        for (int hy = firstRow; hy < height; hy++) {
+            if (std::min(hy * scale + centre, profile.height - 1) >= tile.y + tile.height) {
+                break;
+            }
+            for (int hx = firstCol; hx < width; hx++) {
+                if (std::min(hx * scale + centre, profile.width - 1) >= tile.x + tile.width) {
+                    break;
+                }
+                rgb[(size_t) hy * width + hx] = color;
+            }
+        }
+    }
+}
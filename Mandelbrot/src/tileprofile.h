@@ -0,0 +1,77 @@
+/********************************************************************************************
+* File: tileprofile.h
+* ----------------------
+* v.1 2026/10/17
+* - per-tile render counters, JSON export and heatmap image
+*
+* Profile of one render: where time of kernel, scheduler and output went.
+********************************************************************************************/
+
+#ifndef _tileprofile_h
+#define _tileprofile_h
+
+#include <string>
+#include <vector>
+
+/* Type: TileProfile
+ * -----------------
+ * Counters of one tile of the last render (see TileRenderer).
+ * Tile profiles are collected unless MANDELBROT_NO_TILE_PROFILE
+ * is defined: then TileRenderer has no timing code at all.  */
+struct TileProfile {
+    int x;                      /* Tile position and size in the frame */
+    int y;
+    int width;
+    int height;
+    int worker;                 /* Pool thread which rendered the tile */
+    double queueSeconds;        /* From start of the pass to start of the tile */
+    double seconds;             /* Wall time of the tile, deepening rounds included */
+    long long iterations;       /* Iterations of its pixels, as RenderStats counts them */
+    int interiorPixels;         /* Pixels with depth at the limit */
+    int escapedPixels;          /* Pixels with depth below the limit */
+
+    TileProfile()
+            : x(0), y(0), width(0), height(0), worker(0), queueSeconds(0), seconds(0),
+              iterations(0), interiorPixels(0), escapedPixels(0) {}
+};
+
+/* Type: RenderProfile
+ * -------------------
+ * Tile profiles of the whole frame with render totals.
+ * writeWaitSeconds is time render waited for output of previous
+ * bands (see BandRenderer), 0 if output doesn't overlap render.  */
+struct RenderProfile {
+    int width;
+    int height;
+    int threads;
+    double renderSeconds;
+    double writeWaitSeconds;
+    std::vector<TileProfile> tiles;
+
+    RenderProfile()
+            : width(0), height(0), threads(0), renderSeconds(0), writeWaitSeconds(0) {}
+};
+
+/* Function: writeRenderProfile
+ * ----------------------------
+ * Writes profile to file as JSON document: totals and array of
+ * tiles with fields of TileProfile. Returns false and sets error
+ * if file can't be written.  */
+bool writeRenderProfile(const std::string& filename,
+                        const RenderProfile& profile,
+                        std::string& error);
+
+/* Function: makeHeatmap
+ * ---------------------
+ * Makes coarse image of tile wall time per pixel: every pixel of
+ * heatmap stands for scale x scale pixels of the frame. Colors go
+ * from black (fastest tile) through blue and red to white (the
+ * slowest one); pixels which no tile rendered (mirrored rows) are
+ * gray. Sets heatmap size in width and height.  */
+void makeHeatmap(const RenderProfile& profile,
+                 int scale,
+                 int& width,
+                 int& height,
+                 std::vector<int>& rgb);
+
+#endif
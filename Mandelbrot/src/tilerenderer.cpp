@@ -0,0 +1,727 @@
+/********************************************************************************************
+* File: tilerenderer.cpp
+* ----------------------
+* v.1 2026/10/17
+* - frame is split into tiles, tiles are calculated by work-stealing pool,
+* - cardioide/bulb pixels are skipped, render counters,
+* - kernel options,
+* - Mariani-Silver rectangle subdivision mode,
+* - kernel precision is chosen from pixel spacing,
+* - progressive coarse-to-fine render,
+* - rows mirrored about the real axis are copied, not calculated,
+* - frame can be rendered by bands of rows,
+* - only unknown pixels of a frame can be calculated,
+* - adaptive iterations limit of tiles,
+* - cardioide test and symmetry only for formulas where they are valid,
+* - per-tile profile: time, queue wait, thread, iterations, interior pixels
+*
+* Implementation of the tilerenderer.h interface.
+********************************************************************************************/
+
+#include "tilerenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+int const MIN_SUBDIVIDED_SIDE = 6;  /* Smaller rectangles are calculated pixel by pixel */
+double const AXIS_TOLERANCE = 1e-3; /* Real axis must be so close to row or midway between
+                                     * rows, part of pixel step */
+int const DEPTH_GROWTH = 4;         /* Adaptive limit of tile is raised so many times */
+double const MIN_CAPPED_PART = 0.1;     /* Tile is deepened if so many its pixels reach limit,
+                                         * only they are calculated again */
+
+typedef std::chrono::steady_clock ProfileClock;     /* Clock of tile profiles */
+
+/* Function: getSeconds
+ * --------------------
+ * Returns time from start to end in seconds.  */
+static inline double getSeconds(ProfileClock::time_point start, ProfileClock::time_point end) {
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/* Type: PixelBatch
+ * ----------------
+ * Collects pixels of a tile for one call of vector kernel:
+ * pixels are calculated together, and results are written
+ * to their places in depths buffer. Batch has pixels of
+ * one precision only.  */
+class PixelBatch {
+public:
+    void add(double a, double b, int offset) {
+        this->a.push_back(a);
+        this->b.push_back(b);
+        offsets.push_back(offset);
+    }
+
+    void add(const DoubleDouble& a, const DoubleDouble& b, int offset) {
+        exactA.push_back(a);
+        exactB.push_back(b);
+        offsets.push_back(offset);
+    }
+
+    void calculate(int maxDepth,
+                   const KernelOptions& options,
+                   int* depths,
+                   RenderStats& stats) {
+        int count = (int) offsets.size();
+        if (count > 0) {
+            found.resize(count);
+            if (exactA.empty()) {
+                stats.iterations += calculateMandelbrotPoints(&a[0], &b[0], count, maxDepth,
+                                                              &found[0], options);
+            } else {
+                stats.iterations += calculateMandelbrotPoints(&exactA[0], &exactB[0], count,
+                                                              maxDepth, &found[0], options);
+            }
+            for (int i = 0; i < count; i++) {
+                depths[offsets[i]] = found[i];
+            }
+        }
+        a.clear();
+        b.clear();
+        exactA.clear();
+        exactB.clear();
+        offsets.clear();
+    }
+
+private:
+    std::vector<double> a;
+    std::vector<double> b;
+    std::vector<DoubleDouble> exactA;
+    std::vector<DoubleDouble> exactB;
+    std::vector<int> offsets;   /* Place of pixel in depths buffer */
+    std::vector<int> found;
+};
+
+/* Type: TileJob
+ * -------------
+ * Everything one worker needs to calculate one tile.  */
+struct TileRenderer::TileJob {
+    const FrameGeometry* frame;
+    int maxDepth;
+    KernelOptions options;
+    bool interiorCheck;         /* Cardioide/bulb test is on and valid for formula */
+    KernelPrecision precision;
+    int* depths;
+    int left;                   /* Tile position and size */
+    int top;
+    int width;
+    int height;
+    RenderStats* stats;         /* Worker's counters and regions */
+    std::vector<FilledRegion>* regions;
+    PixelBatch batch;
+    std::vector<char> known;    /* Tile pixels which are calculated yet */
+
+    /* Adds pixel to batch, or sets it at once if it's inside
+     * cardioide or bulb. Pixels which are known yet are skipped. */
+    void addPixel(int col, int row) {
+        char& isKnown = known[(row - top) * width + (col - left)];
+        if (isKnown) {
+            return;
+        }
+        isKnown = 1;
+        double a = frame->toRealValue(col);
+        double b = frame->toImaginaryValue(row);
+        int offset = row * frame->width + col;
+        /* Double precision is enough for cardioide/bulb test: points
+         * which are closer to their border never escape anyway */
+        if (interiorCheck && isInsideCardioidOrBulb(a, b)) {
+            depths[offset] = maxDepth;
+            stats->interiorSkipped++;
+        } else if (precision == PRECISION_DOUBLE_DOUBLE) {
+            batch.add(frame->toRealDoubleDouble(col), frame->toImaginaryDoubleDouble(row), offset);
+        } else {
+            batch.add(a, b, offset);
+        }
+    }
+
+    int depthAt(int col, int row) const {
+        return depths[row * frame->width + col];
+    }
+};
+
+TileRenderer::TileRenderer(int threadCount, int tileSize)
+        : pool(threadCount),
+          tileSize(std::max(1, tileSize)),
+          interiorCheck(true),
+          symmetry(true),
+          mode(RENDER_EVERY_PIXEL),
+          precision(PRECISION_AUTO),
+          usedPrecision(PRECISION_DOUBLE),
+          depthLimit(0) {
+}
+
+int TileRenderer::getThreadCount() const {
+    return pool.getThreadCount();
+}
+
+const RenderStats& TileRenderer::getStats() const {
+    return stats;
+}
+
+const std::vector<FilledRegion>& TileRenderer::getFilledRegions() const {
+    return regions;
+}
+
+const std::vector<TileDepth>& TileRenderer::getTileDepths() const {
+    return tileDepths;
+}
+
+const std::vector<TileProfile>& TileRenderer::getTileProfiles() const {
+    return tileProfiles;
+}
+
+void TileRenderer::setKernelOptions(const KernelOptions& options) {
+    this->options = options;
+}
+
+void TileRenderer::setInteriorCheck(bool enabled) {
+    interiorCheck = enabled;
+}
+
+void TileRenderer::setRenderMode(RenderMode mode) {
+    this->mode = mode;
+}
+
+void TileRenderer::setSymmetry(bool enabled) {
+    symmetry = enabled;
+}
+
+void TileRenderer::setPrecision(KernelPrecision precision) {
+    this->precision = precision;
+}
+
+KernelPrecision TileRenderer::getPrecision() const {
+    return usedPrecision;
+}
+
+void TileRenderer::setAdaptiveDepth(int depthLimit) {
+    this->depthLimit = std::max(0, depthLimit);
+}
+
+void TileRenderer::render(const FrameGeometry& frame, int maxDepth, int* depths) {
+    renderRows(frame, 0, frame.height, maxDepth, depths);
+}
+
+void TileRenderer::renderRows(const FrameGeometry& frame,
+                              int firstRow,
+                              int rowCount,
+                              int maxDepth,
+                              int* depths) {
+    startFrame(frame);
+    FrameGeometry band = frame;
+    band.originRow += firstRow;
+    band.height = rowCount;
+    FrameGeometry half;
+    int rowSum = 0;
+    if (!findCalculatedRows(band, half, rowSum)) {
+        renderPass(band, maxDepth, depths, 1, false);
+        deepenTiles(band, maxDepth, depths, 0);
+        finishTileProfiles(band, maxDepth, depths, 0);
+        return;
+    }
+    int top = half.originRow - band.originRow;
+    renderPass(half, maxDepth, depths + top * band.width, 1, false);
+    deepenTiles(half, maxDepth, depths + top * band.width, top);
+    finishTileProfiles(half, maxDepth, depths + top * band.width, top);
+    for (size_t i = 0; i < regions.size(); i++) {
+        regions[i].y += top;
+    }
+    mirrorRows(band, half, rowSum, depths);
+    stats.pixelsMirrored = (long long) band.width * (band.height - half.height);
+    stats.pixels += stats.pixelsMirrored;
+}
+
+void TileRenderer::renderUnknown(const FrameGeometry& frame,
+                                 int maxDepth,
+                                 int* depths,
+                                 const std::vector<char>& known) {
+    startFrame(frame);
+    renderPass(frame, maxDepth, depths, 1, false, &known[0]);
+    finishTileProfiles(frame, maxDepth, depths, 0);
+}
+
+void TileRenderer::renderProgressive(const FrameGeometry& frame,
+                                     int maxDepth,
+                                     int* depths,
+                                     const PassCallback& passDone) {
+    startFrame(frame);
+    FrameGeometry half;
+    int rowSum = 0;
+    bool mirrored = findCalculatedRows(frame, half, rowSum);
+    int top = mirrored ? (half.originRow - frame.originRow) : 0;
+    const FrameGeometry& calculated = mirrored ? half : frame;
+    int* calculatedDepths = depths + top * frame.width;
+    for (int pass = PROGRESSIVE_PASSES - 1; pass >= 0; pass--) {
+        int cellSize = 1 << pass;
+        renderPass(calculated, maxDepth, calculatedDepths, cellSize, true);
+        if (cellSize == 1) {
+            deepenTiles(calculated, maxDepth, calculatedDepths, top);
+            finishTileProfiles(calculated, maxDepth, calculatedDepths, top);
+        } else if (depthLimit > maxDepth) {
+            /* Coarse image shows pixels at limit as final ones, deepenTiles
+             * takes depths above limit as reached limit */
+            int* end = calculatedDepths + calculated.width * calculated.height;
+            std::replace(calculatedDepths, end, maxDepth, depthLimit);
+        }
+        if (mirrored) {
+            mirrorRows(frame, half, rowSum, depths);
+        }
+        if (mirrored && cellSize == 1) {
+            stats.pixelsMirrored = (long long) frame.width * (frame.height - half.height);
+            stats.pixels += stats.pixelsMirrored;
+        }
+        passDone(cellSize);
+    }
+}
+
+void TileRenderer::startFrame(const FrameGeometry& frame) {
+    usedPrecision = precision;
+    if (usedPrecision == PRECISION_AUTO) {
+        double magnitude = std::max(std::max(std::fabs(frame.reLeft),
+                                             std::fabs(frame.toRealValue(frame.width))),
+                                    std::max(std::fabs(frame.imTop),
+                                             std::fabs(frame.toImaginaryValue(frame.height))));
+        usedPrecision = choosePrecision(frame.step, magnitude);
+    }
+    stats = RenderStats();
+    regions.clear();
+    tileDepths.clear();
+    tileProfiles.clear();
+}
+
+/* Implementation notes: findCalculatedRows
+ * --------------------------------------------------------------------
+ * Real axis b = 0 is at row axis = -imTop / step - originRow.
+ * If 2 * axis is (nearly) integer rowSum, row r and row rowSum - r
+ * are mirror images. Rows which have mirror rows in the frame form
+ * range [first, last] with first + last = rowSum, first = 0 or
+ * last = height - 1. Calculated part is one block of rows: mirrored
+ * rows are taken from the side of the axis which has no other rows.
+ * --------------------------------------------------------------------*/
+bool TileRenderer::findCalculatedRows(const FrameGeometry& frame,
+                                      FrameGeometry& half,
+                                      int& rowSum) const {
+    if (!symmetry || !isConjugateSymmetric(options) || frame.height < 2 || !(frame.step > 0)) {
+        return false;
+    }
+    double axis = -(frame.imTop + frame.imTopLow) / frame.step - frame.originRow;
+    if (!(axis > 0 && axis < frame.height - 1)) {
+        return false;
+    }
+    double sum = std::floor(2 * axis + 0.5);
+    if (std::fabs(2 * axis - sum) > 2 * AXIS_TOLERANCE) {
+        return false;
+    }
+    rowSum = (int) sum;
+    int first = std::max(0, rowSum - (frame.height - 1));
+    half = frame;
+    if (first == 0) {
+        /* Rows 0 ... (rowSum - 1) / 2 are copied from the bottom side */
+        int top = rowSum / 2 + rowSum % 2;
+        half.originRow += top;
+        half.height = frame.height - top;
+    } else {
+        /* Rows rowSum / 2 + 1 ... height - 1 are copied from the top side */
+        half.height = rowSum / 2 + 1;
+    }
+    return half.height < frame.height;
+}
+
+void TileRenderer::mirrorRows(const FrameGeometry& frame,
+                              const FrameGeometry& half,
+                              int rowSum,
+                              int* depths) {
+    int top = half.originRow - frame.originRow;
+    int bottom = top + half.height;
+    for (int row = 0; row < frame.height; row++) {
+        if (row >= top && row < bottom) {
+            continue;
+        }
+        const int* from = depths + (rowSum - row) * frame.width;
+        std::copy(from, from + frame.width, depths + row * frame.width);
+    }
+}
+
+/* Implementation notes: renderPass
+ * --------------------------------------------------------------------
+ * Pass with cell size s calculates pixels with col % s = 0 and
+ * row % s = 0. Pixels of the coarser pass (multiples of 2s) are
+ * skipped, unless it's the first pass. Cells are filled after all
+ * tiles are done: cell can lie on two tiles, and its top-left pixel
+ * may be calculated by other worker.
+ * Frame mask of known pixels is copied into masks of tiles, and
+ * addPixel skips them.
+ * Only full resolution pass is profiled: every tile writes its own
+ * profile, so workers need no lock. Queue wait of tile is time from
+ * start of the pass to start of the tile on its worker.
+ * --------------------------------------------------------------------*/
+void TileRenderer::renderPass(const FrameGeometry& frame,
+                              int maxDepth,
+                              int* depths,
+                              int cellSize,
+                              bool progressive,
+                              const char* known) {
+    int tileCols = (frame.width + tileSize - 1) / tileSize;
+    int tileRows = (frame.height + tileSize - 1) / tileSize;
+    bool refine = progressive && (cellSize < (1 << (PROGRESSIVE_PASSES - 1)));
+    workerStats.assign(pool.getThreadCount(), RenderStats());
+    workerRegions.assign(pool.getThreadCount(), std::vector<FilledRegion>());
+#ifndef MANDELBROT_NO_TILE_PROFILE
+    bool profiled = (cellSize == 1);
+    if (profiled) {
+        tileProfiles.assign(tileCols * tileRows, TileProfile());
+    }
+    ProfileClock::time_point passStart = ProfileClock::now();
+#endif
+
+    pool.run(tileCols * tileRows, [&](int task, int worker) {
+#ifndef MANDELBROT_NO_TILE_PROFILE
+        ProfileClock::time_point tileStart = ProfileClock::now();
+        long long iterationsBefore = workerStats[worker].iterations;
+#endif
+        TileJob job;
+        job.frame = &frame;
+        job.maxDepth = maxDepth;
+        job.options = options;
+        job.interiorCheck = interiorCheck && hasCardioidTest(options.formula);
+        job.precision = usedPrecision;
+        job.depths = depths;
+        job.left = (task % tileCols) * tileSize;
+        job.top = (task / tileCols) * tileSize;
+        job.width = std::min(tileSize, frame.width - job.left);
+        job.height = std::min(tileSize, frame.height - job.top);
+        job.stats = &workerStats[worker];
+        job.regions = &workerRegions[worker];
+        job.known.assign(job.width * job.height, 0);
+        if (known != NULL) {
+            for (int row = 0; row < job.height; row++) {
+                const char* line = known + (job.top + row) * frame.width + job.left;
+                std::copy(line, line + job.width, job.known.begin() + row * job.width);
+            }
+            renderTile(job);
+        } else if (progressive) {
+            renderTilePass(job, cellSize, refine);
+        } else if (mode == RENDER_MARIANI_SILVER) {
+            renderMarianiSilver(job);
+        } else {
+            renderTile(job);
+        }
+        if (cellSize == 1) {
+            job.stats->pixels += job.width * job.height;
+        }
+#ifndef MANDELBROT_NO_TILE_PROFILE
+        if (profiled) {
+            TileProfile& profile = tileProfiles[task];
+            profile.x = job.left;
+            profile.y = job.top;
+            profile.width = job.width;
+            profile.height = job.height;
+            profile.worker = worker;
+            profile.queueSeconds = getSeconds(passStart, tileStart);
+            profile.seconds = getSeconds(tileStart, ProfileClock::now());
+            profile.iterations = job.stats->iterations - iterationsBefore;
+        }
+#endif
+    });
+
+    for (size_t i = 0; i < workerStats.size(); i++) {
+        stats.add(workerStats[i]);
+        regions.insert(regions.end(), workerRegions[i].begin(), workerRegions[i].end());
+    }
+
+    if (cellSize > 1) {
+        for (int row = 0; row < frame.height; row++) {
+            int* line = depths + row * frame.width;
+            const int* sampleLine = depths + (row - row % cellSize) * frame.width;
+            for (int col = 0; col < frame.width; col++) {
+                line[col] = sampleLine[col - col % cellSize];
+            }
+        }
+    }
+}
+
+/* Implementation notes: deepenTiles
+ * --------------------------------------------------------------------
+ * Round of deepening looks at tiles with limit cap: tile is deepened
+ * if at least MIN_CAPPED_PART of its pixels have depth >= cap, and
+ * the tile or one of its 8 neighbours has escaped pixels with depth
+ * >= limit / 2 of that tile. Pixels which escaped keep their depth
+ * with any higher limit, so only pixels at limit are calculated again
+ * with limit cap * DEPTH_GROWTH, from the start of their orbits,
+ * by the kernel options of the caller. Most of them are inside of
+ * the set, so a round without periodicity check costs more than the
+ * previous ones together; it isn't turned on here, as its default
+ * tolerance would change depths of slow pixels at deep zooms. Rounds go on while any tile is deepened and limit is
+ * below depthLimit. Mariani-Silver regions at limit of deepened
+ * tiles are dropped: their pixels are calculated.
+ * --------------------------------------------------------------------*/
+void TileRenderer::deepenTiles(const FrameGeometry& frame, int maxDepth, int* depths,
+                               int rowOffset) {
+    if (depthLimit <= maxDepth) {
+        return;
+    }
+    int tileCols = (frame.width + tileSize - 1) / tileSize;
+    int tileRows = (frame.height + tileSize - 1) / tileSize;
+    int tileCount = tileCols * tileRows;
+    std::vector<int> caps(tileCount, maxDepth);
+    std::vector<int> capped(tileCount);
+    std::vector<char> slow(tileCount);
+    std::vector<int> deepened;
+
+    for (int cap = maxDepth; cap < depthLimit; ) {
+        int nextCap = (int) std::min((long long) depthLimit, (long long) cap * DEPTH_GROWTH);
+        std::fill(capped.begin(), capped.end(), 0);
+        std::fill(slow.begin(), slow.end(), 0);
+        for (int row = 0; row < frame.height; row++) {
+            const int* line = depths + row * frame.width;
+            for (int col = 0; col < frame.width; col++) {
+                int tile = (row / tileSize) * tileCols + col / tileSize;
+                if (line[col] >= caps[tile]) {
+                    capped[tile]++;
+                } else if (2 * line[col] >= caps[tile]) {
+                    slow[tile] = 1;
+                }
+            }
+        }
+
+        deepened.clear();
+        for (int tile = 0; tile < tileCount; tile++) {
+            int tileCol = tile % tileCols;
+            int tileRow = tile / tileCols;
+            int pixels = std::min(tileSize, frame.width - tileCol * tileSize)
+                    * std::min(tileSize, frame.height - tileRow * tileSize);
+            if (caps[tile] != cap || capped[tile] < MIN_CAPPED_PART * pixels) {
+                continue;
+            }
+            bool border = false;
+            int lastRow = std::min(tileRows - 1, tileRow + 1);
+            int lastCol = std::min(tileCols - 1, tileCol + 1);
+            for (int row = std::max(0, tileRow - 1); row <= lastRow; row++) {
+                for (int col = std::max(0, tileCol - 1); col <= lastCol; col++) {
+                    border = border || slow[row * tileCols + col];
+                }
+            }
+            if (border) {
+                deepened.push_back(tile);
+            }
+        }
+        if (deepened.empty()) {
+            break;
+        }
+
+        workerStats.assign(pool.getThreadCount(), RenderStats());
+        pool.run((int) deepened.size(), [&](int task, int worker) {
+            int tile = deepened[task];
+#ifndef MANDELBROT_NO_TILE_PROFILE
+            ProfileClock::time_point tileStart = ProfileClock::now();
+            long long iterationsBefore = workerStats[worker].iterations;
+#endif
+            TileJob job;
+            job.frame = &frame;
+            job.maxDepth = nextCap;
+            job.options = options;
+            job.interiorCheck = interiorCheck && hasCardioidTest(options.formula);
+            job.precision = usedPrecision;
+            job.depths = depths;
+            job.left = (tile % tileCols) * tileSize;
+            job.top = (tile / tileCols) * tileSize;
+            job.width = std::min(tileSize, frame.width - job.left);
+            job.height = std::min(tileSize, frame.height - job.top);
+            job.stats = &workerStats[worker];
+            job.regions = NULL;
+            job.known.assign(job.width * job.height, 0);
+            for (int row = 0; row < job.height; row++) {
+                for (int col = 0; col < job.width; col++) {
+                    job.known[row * job.width + col] =
+                            (job.depthAt(job.left + col, job.top + row) < cap);
+                }
+            }
+            renderTile(job);
+#ifndef MANDELBROT_NO_TILE_PROFILE
+            if (tile < (int) tileProfiles.size()) {
+                tileProfiles[tile].seconds += getSeconds(tileStart, ProfileClock::now());
+                tileProfiles[tile].iterations += job.stats->iterations - iterationsBefore;
+            }
+#endif
+        });
+        for (size_t i = 0; i < workerStats.size(); i++) {
+            stats.iterations += workerStats[i].iterations;
+        }
+        for (size_t i = 0; i < deepened.size(); i++) {
+            if (caps[deepened[i]] == maxDepth) {
+                stats.tilesDeepened++;
+            }
+            caps[deepened[i]] = nextCap;
+        }
+        cap = nextCap;
+    }
+
+    /* Pixels at limit of their tile are inside of the set */
+    for (int row = 0; row < frame.height; row++) {
+        int* line = depths + row * frame.width;
+        for (int col = 0; col < frame.width; col++) {
+            if (line[col] >= caps[(row / tileSize) * tileCols + col / tileSize]) {
+                line[col] = depthLimit;
+            }
+        }
+    }
+    std::vector<FilledRegion> kept;
+    for (size_t i = 0; i < regions.size(); i++) {
+        FilledRegion region = regions[i];
+        int tile = (region.y / tileSize) * tileCols + region.x / tileSize;
+        if (region.depth >= maxDepth) {
+            if (caps[tile] > maxDepth) {
+                continue;
+            }
+            region.depth = depthLimit;
+        }
+        kept.push_back(region);
+    }
+    regions.swap(kept);
+    for (int tile = 0; tile < tileCount; tile++) {
+        TileDepth tileDepth;
+        tileDepth.x = (tile % tileCols) * tileSize;
+        tileDepth.y = (tile / tileCols) * tileSize;
+        tileDepth.width = std::min(tileSize, frame.width - tileDepth.x);
+        tileDepth.height = std::min(tileSize, frame.height - tileDepth.y);
+        tileDepth.y += rowOffset;
+        tileDepth.maxDepth = caps[tile];
+        tileDepths.push_back(tileDepth);
+    }
+}
+
+/* Implementation notes: finishTileProfiles
+ * --------------------------------------------------------------------
+ * Pixels of tile are counted after deepening: pixels inside of the
+ * set have the final limit, depthLimit or maxDepth. Tile positions
+ * are moved from calculated rows to rows of depths buffer.
+ * --------------------------------------------------------------------*/
+void TileRenderer::finishTileProfiles(const FrameGeometry& frame, int maxDepth,
+                                      const int* depths, int rowOffset) {
+#ifndef MANDELBROT_NO_TILE_PROFILE
+    int interiorDepth = std::max(depthLimit, maxDepth);
+    for (size_t i = 0; i < tileProfiles.size(); i++) {
+        TileProfile& profile = tileProfiles[i];
+        for (int row = profile.y; row < profile.y + profile.height; row++) {
+            const int* line = depths + row * frame.width;
+            for (int col = profile.x; col < profile.x + profile.width; col++) {
+                if (line[col] >= interiorDepth) {
+                    profile.interiorPixels++;
+                } else {
+                    profile.escapedPixels++;
+                }
+            }
+        }
+        profile.y += rowOffset;
+    }
+#endif
+}
+
+void TileRenderer::renderTile(TileJob& job) {
+    /* Every tile row is one strip for vector kernel */
+    for (int row = job.top; row < job.top + job.height; row++) {
+        for (int col = job.left; col < job.left + job.width; col++) {
+            job.addPixel(col, row);
+        }
+        job.batch.calculate(job.maxDepth, job.options, job.depths, *job.stats);
+    }
+}
+
+void TileRenderer::renderTilePass(TileJob& job, int cellSize, bool refine) {
+    int coarseSize = 2 * cellSize;
+    int firstRow = job.top + (cellSize - job.top % cellSize) % cellSize;
+    int firstCol = job.left + (cellSize - job.left % cellSize) % cellSize;
+    for (int row = firstRow; row < job.top + job.height; row += cellSize) {
+        for (int col = firstCol; col < job.left + job.width; col += cellSize) {
+            /* Pixel of the previous pass is calculated yet */
+            if (refine && (row % coarseSize == 0) && (col % coarseSize == 0)) {
+                continue;
+            }
+            job.addPixel(col, row);
+        }
+        job.batch.calculate(job.maxDepth, job.options, job.depths, *job.stats);
+    }
+}
+
+void TileRenderer::renderMarianiSilver(TileJob& job) {
+    subdivide(job, job.left, job.top, job.width, job.height);
+}
+
+/* Implementation notes: subdivide
+ * --------------------------------------------------------------------
+ * Neighbour rectangles share their common border line: it is
+ * calculated once, "known" mask of tile remembers calculated pixels.
+ * Rectangle is filled when its border is uniform, filled pixels are
+ * marked as known too, so they are never calculated.
+ * --------------------------------------------------------------------*/
+void TileRenderer::subdivide(TileJob& job, int x, int y, int width, int height) {
+    int right = x + width - 1;
+    int bottom = y + height - 1;
+
+    /* Small rectangle: border check costs nearly as much as
+     * calculation of all its pixels */
+    if (width <= MIN_SUBDIVIDED_SIDE || height <= MIN_SUBDIVIDED_SIDE) {
+        for (int row = y; row <= bottom; row++) {
+            for (int col = x; col <= right; col++) {
+                job.addPixel(col, row);
+            }
+        }
+        job.batch.calculate(job.maxDepth, job.options, job.depths, *job.stats);
+        return;
+    }
+
+    /* Calculates border pixels, which are not known yet */
+    for (int col = x; col <= right; col++) {
+        job.addPixel(col, y);
+        job.addPixel(col, bottom);
+    }
+    for (int row = y + 1; row < bottom; row++) {
+        job.addPixel(x, row);
+        job.addPixel(right, row);
+    }
+    job.batch.calculate(job.maxDepth, job.options, job.depths, *job.stats);
+
+    /* Checks if border is uniform */
+    int borderDepth = job.depthAt(x, y);
+    bool uniform = true;
+    for (int col = x; col <= right && uniform; col++) {
+        uniform = (job.depthAt(col, y) == borderDepth)
+                && (job.depthAt(col, bottom) == borderDepth);
+    }
+    for (int row = y + 1; row < bottom && uniform; row++) {
+        uniform = (job.depthAt(x, row) == borderDepth)
+                && (job.depthAt(right, row) == borderDepth);
+    }
+
+    if (uniform) {
+        FilledRegion region;
+        region.x = x + 1;
+        region.y = y + 1;
+        region.width = width - 2;
+        region.height = height - 2;
+        region.depth = borderDepth;
+        for (int row = region.y; row < region.y + region.height; row++) {
+            for (int col = region.x; col < region.x + region.width; col++) {
+                job.depths[row * job.frame->width + col] = borderDepth;
+                job.known[(row - job.top) * job.width + (col - job.left)] = 1;
+            }
+        }
+        job.regions->push_back(region);
+        job.stats->pixelsFilled += region.width * region.height;
+        return;
+    }
+
+    /* Divides longer side in two halves, which share middle line */
+    if (width >= height) {
+        int middle = x + width / 2;
+        subdivide(job, x, y, middle - x + 1, height);
+        subdivide(job, middle, y, right - middle + 1, height);
+    } else {
+        int middle = y + height / 2;
+        subdivide(job, x, y, width, middle - y + 1);
+        subdivide(job, x, middle, width, bottom - middle + 1);
+    }
+}
@@ -0,0 +1,340 @@
+/********************************************************************************************
+* File: tilerenderer.h
+* ----------------------
+* v.1 2026/10/17
+* - frame is split into tiles, tiles are calculated by work-stealing pool,
+* - cardioide/bulb pixels are skipped, render counters,
+* - kernel options,
+* - Mariani-Silver rectangle subdivision mode,
+* - kernel precision is chosen from pixel spacing,
+* - progressive coarse-to-fine render,
+* - rows mirrored about the real axis are copied, not calculated,
+* - frame can be rendered by bands of rows,
+* - only unknown pixels of a frame can be calculated,
+* - adaptive iterations limit of tiles,
+* - cardioide test and symmetry only for formulas where they are valid,
+* - per-tile profile: time, queue wait, thread, iterations, interior pixels
+*
+* Multithreaded calculation of iterations quantities for whole image.
+********************************************************************************************/
+
+#ifndef _tilerenderer_h
+#define _tilerenderer_h
+
+#include <functional>
+#include <vector>
+#include "mandelbrotkernel.h"
+#include "tileprofile.h"
+#include "workpool.h"
+
+/* Type: FrameGeometry
+ * -------------------
+ * Image size and its position on complex area.
+ * Pixel (col, row) represents c-point:
+ *   a = (originCol + col) * step + reLeft,
+ *   b = (originRow + row) * step + imTop.
+ * Origin is 0 for a single image. Frames which are parts of one
+ * bigger picture (see Viewport) share reLeft and imTop and have
+ * different origins, so the same pixel has the same c-point
+ * in all of them.
+ * For zooms deeper than double precision, reLeftLow and imTopLow
+ * keep the low parts of double-double edge values.  */
+struct FrameGeometry {
+    int width;          /* Image size in pixels */
+    int height;
+    double reLeft;      /* Real value of the column originCol */
+    double imTop;       /* Imaginary value of the row originRow */
+    double step;        /* Complex distance between neighbour pixels */
+    double reLeftLow;   /* Low parts of edge values, 0 by default */
+    double imTopLow;
+    int originCol;      /* Position of the image on the bigger picture, 0 by default */
+    int originRow;
+
+    FrameGeometry()
+            : width(0), height(0), reLeft(0), imTop(0), step(0),
+              reLeftLow(0), imTopLow(0), originCol(0), originRow(0) {}
+
+    double toRealValue(double col) const {
+        return (originCol + col) * step + reLeft;
+    }
+
+    double toImaginaryValue(double row) const {
+        return (originRow + row) * step + imTop;
+    }
+
+    DoubleDouble toRealDoubleDouble(double col) const {
+        return DoubleDouble(reLeft, reLeftLow) + DoubleDouble((originCol + col) * step);
+    }
+
+    DoubleDouble toImaginaryDoubleDouble(double row) const {
+        return DoubleDouble(imTop, imTopLow) + DoubleDouble((originRow + row) * step);
+    }
+};
+
+/* Type: RenderStats
+ * -----------------
+ * Counters of one render() call.  */
+struct RenderStats {
+    long long pixels;           /* Pixels of the frame */
+    long long interiorSkipped;  /* Cardioide/bulb pixels, set to maxDepth without iterations */
+    long long iterations;       /* Iterations made by kernel */
+    long long pixelsFilled;     /* Pixels filled by Mariani-Silver, without kernel */
+    long long pixelsMirrored;   /* Pixels copied from their mirror row */
+    long long pixelsReused;     /* Pixels resampled from other frame, see ZoomAnimator */
+    long long tilesDeepened;    /* Tiles whose iterations limit was raised */
+    long long pixelsRefined;    /* Pixels supersampled, see EdgeAntialiaser */
+
+    RenderStats()
+            : pixels(0), interiorSkipped(0), iterations(0), pixelsFilled(0),
+              pixelsMirrored(0), pixelsReused(0), tilesDeepened(0), pixelsRefined(0) {}
+
+    void add(const RenderStats& other) {
+        pixels += other.pixels;
+        interiorSkipped += other.interiorSkipped;
+        iterations += other.iterations;
+        pixelsFilled += other.pixelsFilled;
+        pixelsMirrored += other.pixelsMirrored;
+        pixelsReused += other.pixelsReused;
+        tilesDeepened += other.tilesDeepened;
+        pixelsRefined += other.pixelsRefined;
+    }
+};
+
+/* Type: FilledRegion
+ * ------------------
+ * Rectangle of pixels with the same iterations quantity,
+ * filled by Mariani-Silver mode without calculations.  */
+struct FilledRegion {
+    int x;
+    int y;
+    int width;
+    int height;
+    int depth;
+};
+
+/* Type: TileDepth
+ * ---------------
+ * Final iterations limit of one tile in adaptive depth mode.  */
+struct TileDepth {
+    int x;
+    int y;
+    int width;
+    int height;
+    int maxDepth;
+};
+
+/* Type: RenderMode
+ * ----------------
+ * RENDER_EVERY_PIXEL - kernel calculates every pixel.
+ * RENDER_MARIANI_SILVER - kernel calculates only border of rectangle
+ *   (initially - of tile). If all border pixels have the same
+ *   iterations quantity, rectangle is filled with it, else rectangle
+ *   is divided in two halves and they are processed the same way.
+ *   Mandelbrot set is connected, so a uniform border seldom hides
+ *   anything: difference with RENDER_EVERY_PIXEL is limited to thin
+ *   filaments which cross no border of rectangle. It is 0 pixels for
+ *   default framing, and less than 0.01% of pixels for zoomed views
+ *   of the set border.  */
+enum RenderMode {
+    RENDER_EVERY_PIXEL,
+    RENDER_MARIANI_SILVER
+};
+
+/* Class: TileRenderer
+ * -------------------
+ * Splits image into square tiles and calculates them on all
+ * cores. Tiles near the cardioide reach maxDepth at every pixel,
+ * while outer tiles escape after a few steps, so tiles are
+ * balanced between threads by WorkStealingPool.  */
+class TileRenderer {
+public:
+    /* Constructor: TileRenderer
+     * -------------------------
+     * @param threadCount   Quantity of threads, <= 0 - one per hardware thread
+     * @param tileSize      Side of square tile in pixels  */
+    explicit TileRenderer(int threadCount = 0, int tileSize = DEFAULT_TILE_SIZE);
+
+    /* Method: render
+     * --------------
+     * Fills depths[row * frame.width + col] with iterations
+     * quantity for every pixel of the frame.  */
+    void render(const FrameGeometry& frame, int maxDepth, int* depths);
+
+    /* Method: renderRows
+     * ------------------
+     * Fills depths[(row - firstRow) * frame.width + col] for rows
+     * firstRow ... firstRow + rowCount - 1 of the frame only. Kernel
+     * precision is chosen for the whole frame, so all bands of one
+     * frame are calculated the same way. Symmetry is used only
+     * inside of the band.  */
+    void renderRows(const FrameGeometry& frame,
+                    int firstRow,
+                    int rowCount,
+                    int maxDepth,
+                    int* depths);
+
+    /* Method: renderUnknown
+     * ---------------------
+     * Calculates only pixels with known[row * frame.width + col]
+     * equal to 0, other pixels of depths are kept as they are.
+     * Render mode and symmetry are not used.  */
+    void renderUnknown(const FrameGeometry& frame,
+                       int maxDepth,
+                       int* depths,
+                       const std::vector<char>& known);
+
+    /* Type: PassCallback
+     * ------------------
+     * Called by renderProgressive after each pass with its cell size.  */
+    typedef std::function<void(int cellSize)> PassCallback;
+
+    /* Method: renderProgressive
+     * -------------------------
+     * Fills depths as render() does, in PROGRESSIVE_PASSES passes
+     * from coarse to fine: the first one calculates every 4th pixel
+     * of every 4th row (cell size 4), the next - every 2nd pixel of
+     * every 2nd row (cell size 2), the last - all pixels. Every pass
+     * calculates only pixels which previous passes didn't.
+     * After each pass every cell (cellSize x cellSize pixels) of depths
+     * is filled with the depth of its top-left pixel (or of its mirror
+     * cell, see setSymmetry), and passDone is called in the caller's
+     * thread, so the image can be shown at once.
+     * Render mode is ignored: every pixel is calculated.  */
+    void renderProgressive(const FrameGeometry& frame,
+                           int maxDepth,
+                           int* depths,
+                           const PassCallback& passDone);
+
+    /* Method: getFilledRegions
+     * ------------------------
+     * Returns rectangles which were filled without calculations
+     * by the last render() call in RENDER_MARIANI_SILVER mode.
+     * Image can be painted by GBufferedImage::fillRegion for each
+     * of them, and by setRGB for all other pixels.  */
+    const std::vector<FilledRegion>& getFilledRegions() const;
+
+    /* Method: getStats
+     * ----------------
+     * Returns counters of the last render() call.  */
+    const RenderStats& getStats() const;
+
+    /* Method: getTileDepths
+     * ---------------------
+     * Returns iterations limit of every calculated tile after the
+     * last render() call in adaptive depth mode, in pixels of depths
+     * buffer. Rows mirrored about the real axis are not covered.  */
+    const std::vector<TileDepth>& getTileDepths() const;
+
+    /* Method: getTileProfiles
+     * -----------------------
+     * Returns counters of every calculated tile after the last
+     * render(), renderRows(), renderUnknown() call or the last pass
+     * of renderProgressive(), in pixels of depths buffer. Rows
+     * mirrored about the real axis are not covered. Collection
+     * costs two clock readings per tile and one look at every pixel;
+     * with MANDELBROT_NO_TILE_PROFILE defined it is compiled out,
+     * and the list is always empty.  */
+    const std::vector<TileProfile>& getTileProfiles() const;
+
+    /* Method: getThreadCount
+     * ----------------------
+     * Returns quantity of threads which calculate tiles.  */
+    int getThreadCount() const;
+
+    /* Method: setKernelOptions
+     * ------------------------
+     * Chooses kernel variant, by default - KernelOptions().  */
+    void setKernelOptions(const KernelOptions& options);
+
+    /* Method: setInteriorCheck
+     * ------------------------
+     * Turns on/off isInsideCardioidOrBulb test before iterations,
+     * it is on by default. Formulas other than FORMULA_MANDELBROT
+     * never use it.  */
+    void setInteriorCheck(bool enabled);
+
+    /* Method: setRenderMode
+     * ---------------------
+     * Chooses render mode, by default - RENDER_EVERY_PIXEL.  */
+    void setRenderMode(RenderMode mode);
+
+    /* Method: setSymmetry
+     * ---------------------
+     * Turns on/off use of conjugate symmetry, it is on by default.
+     * Mandelbrot set is symmetric about the real axis: depth of
+     * a - jb is the same as depth of a + jb. When the real axis
+     * crosses the frame at a pixel row or midway between two rows,
+     * only the larger part of the frame at one side of the axis is
+     * calculated, and the other side is copied row by row.
+     * Formulas without such symmetry (see isConjugateSymmetric)
+     * are calculated in the whole frame.  */
+    void setSymmetry(bool enabled);
+
+    /* Method: setPrecision
+     * --------------------
+     * Chooses kernel precision. By default it is PRECISION_AUTO:
+     * choosePrecision is called for every frame.  */
+    void setPrecision(KernelPrecision precision);
+
+    /* Method: getPrecision
+     * --------------------
+     * Returns kernel precision used by the last render() call.  */
+    KernelPrecision getPrecision() const;
+
+    /* Method: setAdaptiveDepth
+     * ------------------------
+     * Turns on adaptive depth mode with iterations limit up to
+     * depthLimit, 0 turns it off (default).
+     * In this mode, maxDepth of render() is the initial limit of
+     * every tile. Limit of tile is raised four times, again and again up
+     * to depthLimit, while many of its pixels reach limit and the
+     * tile or its neighbours have pixels which escape slowly - signs
+     * of the set border. Then only pixels at the limit are calculated
+     * again, by the kernel options of setKernelOptions: periodicity
+     * check there makes it much faster. Tiles far from the border
+     * keep the initial limit.
+     * Pixels which reach the final limit of their tile get depth
+     * depthLimit, so image is colorized by palette for depthLimit.
+     * Works for render(), renderRows() and the last pass of
+     * renderProgressive().  */
+    void setAdaptiveDepth(int depthLimit);
+
+    static int const DEFAULT_TILE_SIZE = 32;
+    static int const PROGRESSIVE_PASSES = 3;
+
+private:
+    WorkStealingPool pool;
+    int tileSize;
+    KernelOptions options;
+    bool interiorCheck;
+    bool symmetry;
+    RenderMode mode;
+    KernelPrecision precision;
+    KernelPrecision usedPrecision;
+    int depthLimit;
+    RenderStats stats;
+    std::vector<FilledRegion> regions;
+    std::vector<TileDepth> tileDepths;
+    std::vector<TileProfile> tileProfiles;
+    std::vector<RenderStats> workerStats;   /* One slot per worker, no locks */
+    std::vector<std::vector<FilledRegion> > workerRegions;
+
+    /* Job of one tile, see tilerenderer.cpp */
+    struct TileJob;
+
+    void startFrame(const FrameGeometry& frame);
+    bool findCalculatedRows(const FrameGeometry& frame, FrameGeometry& half, int& rowSum) const;
+    void mirrorRows(const FrameGeometry& frame, const FrameGeometry& half, int rowSum,
+                    int* depths);
+    void renderPass(const FrameGeometry& frame, int maxDepth, int* depths,
+                    int cellSize, bool progressive, const char* known = NULL);
+    void deepenTiles(const FrameGeometry& frame, int maxDepth, int* depths, int rowOffset);
+    void finishTileProfiles(const FrameGeometry& frame, int maxDepth, const int* depths,
+                            int rowOffset);
+    void renderTile(TileJob& job);
+    void renderTilePass(TileJob& job, int cellSize, bool refine);
+    void renderMarianiSilver(TileJob& job);
+    void subdivide(TileJob& job, int x, int y, int width, int height);
+};
+
+#endif
@@ -0,0 +1,77 @@
+/********************************************************************************************
+* File: viewport.cpp
+* ----------------------
+* v.1 2026/10/17
+* - visible part of complex area: centre, scale and size,
+* - panning by whole pixels
+*
+* Implementation of the viewport.h interface.
+********************************************************************************************/
+
+#include "viewport.h"
+
+Viewport::Viewport(int width, int height, double centreRe, double centreIm, double step)
+        : width(width),
+          height(height),
+          step(step) {
+    setCentre(centreRe, centreIm);
+}
+
+int Viewport::getWidth() const {
+    return width;
+}
+
+int Viewport::getHeight() const {
+    return height;
+}
+
+double Viewport::getCentreRe() const {
+    return (originCol + width / 2) * step + anchorRe;
+}
+
+double Viewport::getCentreIm() const {
+    return (originRow + height / 2) * step + anchorIm;
+}
+
+double Viewport::getStep() const {
+    return step;
+}
+
+void Viewport::pan(int dx, int dy) {
+    originCol += dx;
+    originRow += dy;
+}
+
+void Viewport::zoom(double factor) {
+    double centreRe = getCentreRe();
+    double centreIm = getCentreIm();
+    step *= factor;
+    setCentre(centreRe, centreIm);
+}
+
+void Viewport::resize(int width, int height) {
+    double centreRe = getCentreRe();
+    double centreIm = getCentreIm();
+    this->width = width;
+    this->height = height;
+    setCentre(centreRe, centreIm);
+}
+
+FrameGeometry Viewport::getFrameGeometry() const {
+    FrameGeometry frame;
+    frame.width = width;
+    frame.height = height;
+    frame.reLeft = anchorRe;
+    frame.imTop = anchorIm;
+    frame.step = step;
+    frame.originCol = originCol;
+    frame.originRow = originRow;
+    return frame;
+}
+
+void Viewport::setCentre(double centreRe, double centreIm) {
+    anchorRe = centreRe - (width / 2) * step;
+    anchorIm = centreIm - (height / 2) * step;
+    originCol = 0;
+    originRow = 0;
+}
@@ -0,0 +1,75 @@
+/********************************************************************************************
+* File: viewport.h
+* ----------------------
+* v.1 2026/10/17
+* - visible part of complex area: centre, scale and size,
+* - panning by whole pixels
+*
+* Position of program image on the complex area.
+********************************************************************************************/
+
+#ifndef _viewport_h
+#define _viewport_h
+
+#include "tilerenderer.h"
+
+/* Class: Viewport
+ * ---------------
+ * Image of width x height pixels with centre pixel (width / 2,
+ * height / 2) at c-point centreRe + j * centreIm, and complex
+ * distance step between neighbour pixels.
+ *
+ * Viewport is a window on an endless picture: its pixel (0, 0)
+ * is the c-point anchor. Panning moves the window by whole pixels
+ * and keeps the anchor, so pixels which stay visible keep exactly
+ * the same c-points (see FrameGeometry) and need no recalculation.
+ * Zooming and resizing make a new picture with a new anchor.  */
+class Viewport {
+public:
+    /* Constructor: Viewport
+     * ---------------------
+     * @param width, height     Image size in pixels
+     * @param centreRe          Real value of the centre pixel
+     * @param centreIm          Imaginary value of the centre pixel
+     * @param step              Complex distance between neighbour pixels  */
+    Viewport(int width, int height, double centreRe, double centreIm, double step);
+
+    int getWidth() const;
+    int getHeight() const;
+    double getCentreRe() const;
+    double getCentreIm() const;
+    double getStep() const;
+
+    /* Method: pan
+     * -----------
+     * Moves image by dx pixels right and dy pixels down.  */
+    void pan(int dx, int dy);
+
+    /* Method: zoom
+     * ------------
+     * Multiplies step by factor: factor < 1 zooms in. Centre stays.  */
+    void zoom(double factor);
+
+    /* Method: resize
+     * --------------
+     * Changes image size. Centre and step stay.  */
+    void resize(int width, int height);
+
+    /* Method: getFrameGeometry
+     * ------------------------
+     * Returns frame of the image for TileRenderer.  */
+    FrameGeometry getFrameGeometry() const;
+
+private:
+    int width;
+    int height;
+    double anchorRe;    /* c-point of the picture pixel (0, 0) */
+    double anchorIm;
+    double step;
+    int originCol;      /* Picture pixel of the image left-top corner */
+    int originRow;
+
+    void setCentre(double centreRe, double centreIm);
+};
+
+#endif
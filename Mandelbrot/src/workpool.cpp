@@ -0,0 +1,150 @@
+/********************************************************************************************
+* File: workpool.cpp
+* ----------------------
+* v.1 2026/10/17
+* - work-stealing thread pool
+*
+* Implementation of the workpool.h interface.
+********************************************************************************************/
+
+#include "workpool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+        : currentTask(NULL),
+          batch(0),
+          remaining(0),
+          activeWorkers(0),
+          stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = (int) std::thread::hardware_concurrency();
+    }
+    if (threadCount <= 0) {
+        threadCount = 1;
+    }
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(new WorkerQueue);
+    }
+    /* Worker 0 is the thread which calls run() */
+    for (int i = 1; i < threadCount; i++) {
+        threads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    started.notify_all();
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    for (size_t i = 0; i < queues.size(); i++) {
+        delete queues[i];
+    }
+}
+
+int WorkStealingPool::getThreadCount() const {
+    return (int) queues.size();
+}
+
+void WorkStealingPool::run(int taskCount, const Task& task) {
+    if (taskCount <= 0) {
+        return;
+    }
+
+    /* Every worker starts with contiguous block of tasks:
+     * neighbour tiles share cache lines and have similar cost */
+    int workers = getThreadCount();
+    for (int w = 0; w < workers; w++) {
+        int first = (int) ((long long) taskCount * w / workers);
+        int last = (int) ((long long) taskCount * (w + 1) / workers);
+        std::lock_guard<std::mutex> guard(queues[w]->lock);
+        for (int t = first; t < last; t++) {
+            queues[w]->tasks.push_back(t);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        currentTask = &task;
+        remaining = taskCount;
+        batch++;
+    }
+    started.notify_all();
+
+    int done = runTasks(0, task);
+
+    /* Waits for the last tasks, and for workers which are still
+     * looking for tasks in queues - the next batch is put there */
+    std::unique_lock<std::mutex> guard(lock);
+    remaining -= done;
+    while (remaining > 0 || activeWorkers > 0) {
+        finished.wait(guard);
+    }
+    currentTask = NULL;
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    long seenBatch = 0;
+    while (true) {
+        const Task* task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            while (!stopping && (batch == seenBatch || currentTask == NULL)) {
+                started.wait(guard);
+            }
+            if (stopping) {
+                return;
+            }
+            seenBatch = batch;
+            task = currentTask;
+            activeWorkers++;
+        }
+
+        int done = runTasks(worker, *task);
+
+        std::lock_guard<std::mutex> guard(lock);
+        remaining -= done;
+        activeWorkers--;
+        if (remaining == 0 && activeWorkers == 0) {
+            finished.notify_all();
+        }
+    }
+}
+
+int WorkStealingPool::runTasks(int worker, const Task& task) {
+    int taskNumber;
+    int done = 0;
+    while (takeTask(worker, taskNumber)) {
+        task(taskNumber, worker);
+        done++;
+    }
+    return done;
+}
+
+bool WorkStealingPool::takeTask(int worker, int& task) {
+    /* Own queue: the most recently added task */
+    {
+        WorkerQueue* own = queues[worker];
+        std::lock_guard<std::mutex> guard(own->lock);
+        if (!own->tasks.empty()) {
+            task = own->tasks.back();
+            own->tasks.pop_back();
+            return true;
+        }
+    }
+    /* Other queues: the oldest task, it is the farthest
+     * from the tasks their owners are working on now */
+    int workers = getThreadCount();
+    for (int i = 1; i < workers; i++) {
+        WorkerQueue* victim = queues[(worker + i) % workers];
+        std::lock_guard<std::mutex> guard(victim->lock);
+        if (!victim->tasks.empty()) {
+            task = victim->tasks.front();
+            victim->tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
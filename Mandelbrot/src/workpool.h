@@ -0,0 +1,82 @@
+/********************************************************************************************
+* File: workpool.h
+* ----------------------
+* v.1 2026/10/17
+* - work-stealing thread pool
+*
+* Thread pool for independent render tasks of very different cost.
+********************************************************************************************/
+
+#ifndef _workpool_h
+#define _workpool_h
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Class: WorkStealingPool
+ * -----------------------
+ * Runs batches of numbered tasks on a fixed set of threads.
+ * Every worker owns a queue of task numbers: it takes tasks from
+ * the back of its own queue, and when it's empty - steals from
+ * the front of other workers' queues. So workers which got cheap
+ * tasks help the ones which got expensive tasks, and no core
+ * stays idle while there is work.
+ * Thread which calls run() works as worker 0.  */
+class WorkStealingPool {
+public:
+    /* Type: Task
+     * ----------
+     * Task body: gets task number and number of worker which runs it. */
+    typedef std::function<void(int task, int worker)> Task;
+
+    /* Constructor: WorkStealingPool
+     * -----------------------------
+     * Creates pool with threadCount workers (including caller of run).
+     * If threadCount <= 0 - uses quantity of hardware threads.  */
+    explicit WorkStealingPool(int threadCount = 0);
+    ~WorkStealingPool();
+
+    /* Method: getThreadCount
+     * ----------------------
+     * Returns quantity of workers.  */
+    int getThreadCount() const;
+
+    /* Method: run
+     * -----------
+     * Runs task(0) ... task(taskCount - 1) and returns when all
+     * of them are finished. Tasks must not call run() themselves.  */
+    void run(int taskCount, const Task& task);
+
+private:
+    /* Worker queue of task numbers */
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<int> tasks;
+    };
+
+    std::vector<WorkerQueue*> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex lock;                    /* Guards fields below */
+    std::condition_variable started;
+    std::condition_variable finished;
+    const Task* currentTask;
+    long batch;                         /* Number of current batch */
+    int remaining;                      /* Unfinished tasks of current batch */
+    int activeWorkers;                  /* Workers which are taking tasks now */
+    bool stopping;
+
+    void workerLoop(int worker);
+    int runTasks(int worker, const Task& task);
+    bool takeTask(int worker, int& task);
+
+    /* Pool can't be copied */
+    WorkStealingPool(const WorkStealingPool&);
+    WorkStealingPool& operator=(const WorkStealingPool&);
+};
+
+#endif
@@ -0,0 +1,149 @@
+/********************************************************************************************
+* File: zoomanimation.cpp
+* ----------------------
+* v.1 2026/10/17
+* - frames of zoom path from keyframes,
+* - iterations quantities of the previous frame are resampled
+*
+* Implementation of the zoomanimation.h interface.
+********************************************************************************************/
+
+#include "zoomanimation.h"
+#include <algorithm>
+#include <cmath>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+double const MAX_ZOOM_RATIO = 2.0;          /* Step ratio of frames which are resampled */
+double const SAME_POINT_TOLERANCE = 1e-6;   /* Part of step: pixel has c-point of
+                                             * previous pixel */
+
+FrameGeometry getZoomFrame(const std::vector<ZoomKeyframe>& path,
+                           double time,
+                           int width,
+                           int height) {
+    size_t next = 0;
+    while (next < path.size() && path[next].time < time) {
+        next++;
+    }
+    ZoomKeyframe key = path[std::min(next, path.size() - 1)];
+    if (next > 0 && next < path.size()) {
+        const ZoomKeyframe& from = path[next - 1];
+        const ZoomKeyframe& to = path[next];
+        double t = (time - from.time) / (to.time - from.time);
+        key.centreRe = from.centreRe + t * (to.centreRe - from.centreRe);
+        key.centreIm = from.centreIm + t * (to.centreIm - from.centreIm);
+        key.step = from.step * std::pow(to.step / from.step, t);
+    }
+    FrameGeometry frame;
+    frame.width = width;
+    frame.height = height;
+    frame.step = key.step;
+    frame.reLeft = key.centreRe - (width / 2) * key.step;
+    frame.imTop = key.centreIm - (height / 2) * key.step;
+    return frame;
+}
+
+ZoomAnimator::ZoomAnimator(TileRenderer& renderer)
+        : renderer(renderer),
+          maxDepth(0),
+          valid(false) {
+}
+
+const RenderStats& ZoomAnimator::getStats() const {
+    return stats;
+}
+
+void ZoomAnimator::clear() {
+    valid = false;
+}
+
+const std::vector<int>& ZoomAnimator::render(const FrameGeometry& next, int maxDepth) {
+    int size = next.width * next.height;
+    previous.swap(depths);
+    previousAges.swap(ages);
+    depths.assign(size, 0);
+    ages.assign(size, 0);
+    known.assign(size, 0);
+    if (isResampled(next, maxDepth)) {
+        resample(next);
+    }
+    renderer.renderUnknown(next, maxDepth, &depths[0], known);
+    stats = renderer.getStats();
+    stats.pixelsReused = std::count(known.begin(), known.end(), 1);
+
+    frame = next;
+    this->maxDepth = maxDepth;
+    valid = true;
+    return depths;
+}
+
+bool ZoomAnimator::isResampled(const FrameGeometry& next, int nextMaxDepth) const {
+    if (!valid || nextMaxDepth != maxDepth || !(next.step > 0)) {
+        return false;
+    }
+    double ratio = frame.step / next.step;
+    return ratio <= MAX_ZOOM_RATIO && ratio >= 1 / MAX_ZOOM_RATIO;
+}
+
+/* Implementation notes: resample
+ * --------------------------------------------------------------------
+ * Pixel (col, row) is at (x, y) of the previous frame:
+ *   x = (next.reLeft - frame.reLeft + (next.originCol + col) * next.step)
+ *       / frame.step - frame.originCol,
+ * the same for y. Difference of edges is taken first: at deep
+ * zooms edges are close, and their difference keeps precision.
+ * Pixel which hits previous pixel has the same c-point and takes its
+ * depth and age. Otherwise four previous pixels around (x, y) must
+ * have the same depth, and none of them may be MAX_REUSE_AGE old.
+ * --------------------------------------------------------------------*/
+void ZoomAnimator::resample(const FrameGeometry& next) {
+    double reShift = (next.reLeft - frame.reLeft) + (next.reLeftLow - frame.reLeftLow);
+    double imShift = (next.imTop - frame.imTop) + (next.imTopLow - frame.imTopLow);
+    for (int row = 0; row < next.height; row++) {
+        double y = (imShift + (next.originRow + row) * next.step) / frame.step
+                - frame.originRow;
+        double nearestRow = std::floor(y + 0.5);
+        bool rowHit = std::fabs(y - nearestRow) < SAME_POINT_TOLERANCE;
+        int top = (int) std::floor(y);
+        if (rowHit) {
+            top = (int) nearestRow;
+        }
+        if (top < 0 || top >= frame.height || (!rowHit && top + 1 >= frame.height)) {
+            continue;
+        }
+        for (int col = 0; col < next.width; col++) {
+            double x = (reShift + (next.originCol + col) * next.step) / frame.step
+                    - frame.originCol;
+            double nearestCol = std::floor(x + 0.5);
+            int offset = row * next.width + col;
+            if (rowHit && std::fabs(x - nearestCol) < SAME_POINT_TOLERANCE) {
+                int left = (int) nearestCol;
+                if (left >= 0 && left < frame.width) {
+                    depths[offset] = previous[top * frame.width + left];
+                    ages[offset] = previousAges[top * frame.width + left];
+                    known[offset] = 1;
+                }
+                continue;
+            }
+            int left = (int) std::floor(x);
+            if (left < 0 || left + 1 >= frame.width || top + 1 >= frame.height) {
+                continue;
+            }
+            int corners[4] = {top * frame.width + left, top * frame.width + left + 1,
+                              (top + 1) * frame.width + left, (top + 1) * frame.width + left + 1};
+            int depth = previous[corners[0]];
+            int age = 0;
+            bool uniform = true;
+            for (int i = 0; i < 4 && uniform; i++) {
+                uniform = (previous[corners[i]] == depth);
+                age = std::max(age, (int) previousAges[corners[i]]);
+            }
+            if (uniform && age < MAX_REUSE_AGE) {
+                depths[offset] = depth;
+                ages[offset] = (char) (age + 1);
+                known[offset] = 1;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/********************************************************************************************
+* File: zoomanimation.h
+* ----------------------
+* v.1 2026/10/17
+* - frames of zoom path from keyframes,
+* - iterations quantities of the previous frame are resampled
+*
+* Zoom animations: one image per video frame.
+********************************************************************************************/
+
+#ifndef _zoomanimation_h
+#define _zoomanimation_h
+
+#include <vector>
+#include "tilerenderer.h"
+
+/* Type: ZoomKeyframe
+ * ------------------
+ * Image centre and pixel step at some moment of animation.  */
+struct ZoomKeyframe {
+    double time;
+    double centreRe;
+    double centreIm;
+    double step;
+};
+
+/* Function: getZoomFrame
+ * ----------------------
+ * Returns width x height frame at the moment time of the path,
+ * which is sorted by time. Between keyframes centre moves linearly
+ * and step changes geometrically, so zoom speed is constant.
+ * Time before the first keyframe or after the last one gets the
+ * nearest keyframe.  */
+FrameGeometry getZoomFrame(const std::vector<ZoomKeyframe>& path,
+                           double time,
+                           int width,
+                           int height);
+
+/* Class: ZoomAnimator
+ * -------------------
+ * Renders frames of animation one after another. Frame which
+ * zooms or pans the previous one by a modest ratio takes part of
+ * pixels from it: pixel whose c-point lies between four previous
+ * pixels of the same depth gets this depth, and only the other
+ * pixels are calculated. Far from the set border, most of frame
+ * is reused. Frames whose steps differ more than twice, or have
+ * other maxDepth, are calculated fully.
+ * Resampled depth is a guess, which misses details smaller than
+ * the previous pixels. So pixels are never resampled more than
+ * MAX_REUSE_AGE frames in a row: details appear with a short delay
+ * at most.  */
+class ZoomAnimator {
+public:
+    /* Constructor: ZoomAnimator
+     * -------------------------
+     * @param renderer      Renderer of calculated pixels, its
+     *                      options are used as they are  */
+    explicit ZoomAnimator(TileRenderer& renderer);
+
+    /* Method: render
+     * --------------
+     * Returns iterations quantities of the frame, row by row.  */
+    const std::vector<int>& render(const FrameGeometry& frame, int maxDepth);
+
+    /* Method: getStats
+     * ----------------
+     * Returns counters of the last render() call,
+     * pixelsReused - pixels taken from the previous frame.  */
+    const RenderStats& getStats() const;
+
+    /* Method: clear
+     * -------------
+     * Forgets the previous frame: the next one is calculated fully.  */
+    void clear();
+
+    static int const MAX_REUSE_AGE = 2;
+
+private:
+    TileRenderer& renderer;
+    FrameGeometry frame;        /* The previous frame */
+    int maxDepth;
+    bool valid;
+    std::vector<int> depths;
+    std::vector<int> previous;
+    std::vector<char> ages;     /* Frames in a row pixel was resampled, 0 - calculated */
+    std::vector<char> previousAges;
+    std::vector<char> known;    /* Pixels which need no calculation */
+    RenderStats stats;
+
+    bool isResampled(const FrameGeometry& next, int nextMaxDepth) const;
+    void resample(const FrameGeometry& next);
+
+    /* Animator can't be copied */
+    ZoomAnimator(const ZoomAnimator&);
+    ZoomAnimator& operator=(const ZoomAnimator&);
+};
+
+#endif
@@ -5,6 +5,10 @@
  * See that file for documentation of each member.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - added setPixels methods for bulk pixel upload
+ * - added deferred mode with dirty region and flush
+ * - deferred changes are flushed by a platform flush hook, also at exit
  * @version 2014/10/22
  * - added load, save methods
  * @version 2014/10/08
@@ -14,7 +18,9 @@
  */
 
 #include "gbufferedimage.h"
+#include <algorithm>
 #include <iomanip>
+#include <set>
 #include "base64.h"
 #include "filelib.h"
 #include "gwindow.h"
@@ -22,6 +28,13 @@
 
 static Platform* pp = getPlatform();
 
+// images in deferred mode that have changes not yet flushed; never destroyed,
+// because flushAll runs from atexit, after static objects may be gone
+static std::set<GBufferedImage*>& getDirtyImages() {
+    static std::set<GBufferedImage*>* dirtyImages = new std::set<GBufferedImage*>();
+    return *dirtyImages;
+}
+
 GBufferedImage::GBufferedImage() {
     init(0, 0, 0, 0, 0x000000);
 }
@@ -45,6 +58,11 @@ GBufferedImage::GBufferedImage(double x, double y, double width, double height,
     init(x, y, width, height, convertColorToRGB(rgbBackground));
 }
 
+GBufferedImage::~GBufferedImage() {
+    // deferred changes are dropped (see header): the back-end image goes too
+    getDirtyImages().erase(this);
+}
+
 GRectangle GBufferedImage::getBounds() const {
     return GRectangle(x, y, m_width, m_height);
 }
@@ -113,7 +131,11 @@ GBufferedImage* GBufferedImage::diff(GBufferedImage& image, int diffPixelColor)
 void GBufferedImage::fill(int rgb) {
     checkColor("fill", rgb);
     m_pixels.fill(rgb);
-    pp->gbufferedimage_fill(this, rgb);
+    if (m_deferred) {
+        markDirty(0, 0, (int) m_width, (int) m_height);
+    } else {
+        pp->gbufferedimage_fill(this, rgb);
+    }
 }
 
 void GBufferedImage::fill(std::string rgb) {
@@ -129,13 +151,34 @@ void GBufferedImage::fillRegion(double x, double y, double width, double height,
             m_pixels[r][c] = rgb;
         }
     }
-    pp->gbufferedimage_fillRegion(this, x, y, width, height, rgb);
+    if (m_deferred) {
+        markDirty((int) x, (int) y, (int) width, (int) height);
+    } else {
+        pp->gbufferedimage_fillRegion(this, x, y, width, height, rgb);
+    }
 }
 
 void GBufferedImage::fillRegion(double x, double y, double width, double height, std::string rgb) {
     fillRegion(x, y, width, height, convertColorToRGB(rgb));
 }
 
+void GBufferedImage::flush() {
+    if (m_dirtyRight > m_dirtyLeft && m_dirtyBottom > m_dirtyTop) {
+        pp->gbufferedimage_setPixels(this, m_pixels, m_dirtyLeft, m_dirtyTop,
+                                     m_dirtyRight - m_dirtyLeft, m_dirtyBottom - m_dirtyTop);
+    }
+    m_dirtyLeft = m_dirtyTop = m_dirtyRight = m_dirtyBottom = 0;
+    getDirtyImages().erase(this);
+}
+
+void GBufferedImage::flushAll() {
+    std::set<GBufferedImage*> images;
+    images.swap(getDirtyImages());
+    for (std::set<GBufferedImage*>::iterator it = images.begin(); it != images.end(); ++it) {
+        (*it)->flush();
+    }
+}
+
 double GBufferedImage::getHeight() const {
     return m_height;
 }
@@ -157,6 +200,10 @@ bool GBufferedImage::inBounds(double x, double y) const {
     return m_pixels.inBounds((int) y, (int) x);
 }
 
+bool GBufferedImage::isDeferred() const {
+    return m_deferred;
+}
+
 void GBufferedImage::load(const std::string& filename) {
     // for efficiency, let's at least check whether the file exists
     // and throw error immediately rather than contacting the back-end
@@ -164,6 +211,9 @@ void GBufferedImage::load(const std::string& filename) {
         error("GBufferedImage::load: file not found: " + filename);
     }
     
+    // loaded pixels replace any deferred changes
+    m_dirtyLeft = m_dirtyTop = m_dirtyRight = m_dirtyBottom = 0;
+    getDirtyImages().erase(this);
     std::string result = pp->gbufferedimage_load(this, filename);
     result = Base64::decode(result);
     std::istringstream input(result);
@@ -189,6 +239,7 @@ void GBufferedImage::load(const std::string& filename) {
 }
 
 void GBufferedImage::resize(double width, double height, bool retain) {
+    flush();
     this->m_width = width;
     this->m_height = height;
     pp->gbufferedimage_resize(this, width, height, retain);
@@ -199,20 +250,79 @@ void GBufferedImage::resize(double width, double height, bool retain) {
 }
 
 void GBufferedImage::save(const std::string& filename) const {
+    const_cast<GBufferedImage*>(this)->flush();
     pp->gbufferedimage_save(this, filename);
 }
 
+void GBufferedImage::setDeferred(bool deferred) {
+    if (!deferred) {
+        flush();
+    }
+    m_deferred = deferred;
+}
+
 void GBufferedImage::setRGB(double x, double y, int rgb) {
     checkIndex("setRGB", x, y);
     checkColor("setRGB", rgb);
     m_pixels[(int) y][(int) x] = rgb;
-    pp->gbufferedimage_setRGB(this, x, y, rgb);
+    if (m_deferred) {
+        markDirty((int) x, (int) y, 1, 1);
+    } else {
+        pp->gbufferedimage_setRGB(this, x, y, rgb);
+    }
 }
 
 void GBufferedImage::setRGB(double x, double y, std::string rgb) {
     setRGB(x, y, convertColorToRGB(rgb));
 }
 
+void GBufferedImage::setPixels(const Grid<int>& pixels) {
+    if (pixels.numRows() != (int) m_height || pixels.numCols() != (int) m_width) {
+        error("GBufferedImage::setPixels: grid size must be equal to image size");
+    }
+    setPixels(0, 0, pixels);
+}
+
+void GBufferedImage::setPixels(double x, double y, const Grid<int>& pixels) {
+    int width = pixels.numCols();
+    int height = pixels.numRows();
+    checkRange("setPixels", x, y, width, height);
+    for (int r = 0; r < height; r++) {
+        for (int c = 0; c < width; c++) {
+            int rgb = pixels[r][c];
+            if (rgb < 0x0 || rgb > 0xffffff) {
+                checkColor("setPixels", rgb);
+            }
+            m_pixels[(int) y + r][(int) x + c] = rgb;
+        }
+    }
+    if (m_deferred) {
+        markDirty((int) x, (int) y, width, height);
+    } else if (width > 0 && height > 0) {
+        pp->gbufferedimage_setPixels(this, m_pixels, (int) x, (int) y, width, height);
+    }
+}
+
+void GBufferedImage::setPixels(double x, double y, double width, double height, const int* rgb) {
+    checkRange("setPixels", x, y, width, height);
+    int w = (int) width;
+    int h = (int) height;
+    for (int r = 0; r < h; r++) {
+        for (int c = 0; c < w; c++) {
+            int px = rgb[r * w + c];
+            if (px < 0x0 || px > 0xffffff) {
+                checkColor("setPixels", px);
+            }
+            m_pixels[(int) y + r][(int) x + c] = px;
+        }
+    }
+    if (m_deferred) {
+        markDirty((int) x, (int) y, w, h);
+    } else if (w > 0 && h > 0) {
+        pp->gbufferedimage_setPixels(this, m_pixels, (int) x, (int) y, w, h);
+    }
+}
+
 void GBufferedImage::checkColor(std::string member, int rgb) const {
     if (rgb < 0x0 || rgb > 0xffffff) {
         error("GBufferedImage::" + member
@@ -237,6 +347,36 @@ void GBufferedImage::checkSize(std::string member, double width, double height)
     }
 }
 
+void GBufferedImage::checkRange(std::string member, double x, double y,
+                                double width, double height) const {
+    checkSize(member, width, height);
+    if ((int) width > 0 && (int) height > 0) {
+        checkIndex(member, x, y);
+        checkIndex(member, x + (int) width - 1, y + (int) height - 1);
+    }
+}
+
+void GBufferedImage::markDirty(int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (m_dirtyRight <= m_dirtyLeft) {
+        m_dirtyLeft = x;
+        m_dirtyTop = y;
+        m_dirtyRight = x + width;
+        m_dirtyBottom = y + height;
+        if (getDirtyImages().empty()) {
+            pp->cpplib_addFlushHook(flushAll);
+        }
+        getDirtyImages().insert(this);
+    } else {
+        m_dirtyLeft = std::min(m_dirtyLeft, x);
+        m_dirtyTop = std::min(m_dirtyTop, y);
+        m_dirtyRight = std::max(m_dirtyRight, x + width);
+        m_dirtyBottom = std::max(m_dirtyBottom, y + height);
+    }
+}
+
 void GBufferedImage::init(double x, double y, double width, double height,
                           int rgb) {
     checkSize("constructor", width, height);
@@ -246,6 +386,8 @@ void GBufferedImage::init(double x, double y, double width, double height,
     this->m_width = width;
     this->m_height = height;
     this->m_pixels.resize((int) this->m_height, (int) this->m_width);
+    this->m_deferred = false;
+    this->m_dirtyLeft = this->m_dirtyTop = this->m_dirtyRight = this->m_dirtyBottom = 0;
     pp->gbufferedimage_constructor(this, x, y, width, height, rgb);
 
     if (x != 0 || y != 0) {
@@ -4,6 +4,10 @@
  * This file exports the GBufferedImage class for per-pixel graphics.
  *
  * @author Marty Stepp
+ * @version 2026/10/17
+ * - added setPixels methods for bulk pixel upload
+ * - added deferred mode with dirty region and flush
+ * - deferred changes are flushed at exit; destructor documents their loss
  * @version 2014/10/22
  * - added save, load methods
  * - added three-argument constructor (w, h, background)
@@ -55,7 +59,10 @@
  * relatively slow.  A call to the <code>fill</code> method is relatively
  * efficient, and a call to <code>getRGB</code> is also efficient since pixels'
  * colors are cached locally.  But calling <code>setRGB</code> repeatedly over
- * a large range of pixels is likely to yield poor performance.
+ * a large range of pixels is likely to yield poor performance: prefer
+ * the <code>setPixels</code> methods, which send a whole range at once,
+ * or turn on deferred mode (<code>setDeferred</code>), in which changes
+ * are kept locally until the next <code>flush</code>.
  * This is due to the fact that the graphics are implemented using a background
  * Java process to which all graphical commands are forwarded.
  * The <code>GBufferedImage</code> class is not performant enough to be used
@@ -90,6 +97,14 @@ public:
     GBufferedImage(double x, double y, double width, double height,
                    std::string rgbBackground);
 
+    /*
+     * Frees the image.  Its deferred changes that are not flushed yet are
+     * dropped, not sent: the back-end image is deleted together with this
+     * object, so they could never be shown.  Call flush or save first to keep
+     * them, e.g. in a file.
+     */
+    virtual ~GBufferedImage();
+
     /* Prototypes for the virtual methods */
     virtual GRectangle getBounds() const;
     virtual std::string getType() const;
@@ -137,6 +152,21 @@ public:
     void fillRegion(double x, double y, double width, double height,
                     std::string rgb);
 
+    /*
+     * Sends the pixels changed in deferred mode to the Java back-end in one
+     * batched upload: the bounding rectangle of all changes since the last
+     * flush.  Does nothing if there are no such changes.
+     */
+    void flush();
+
+    /*
+     * Flushes every image that has deferred changes.  Registered as flush hook
+     * of the platform, which calls it before GWindow repaint, pause, and event
+     * waits, and at exit, so that the window shows the pixels a program has
+     * set; programs need not call it themselves.
+     */
+    static void flushAll();
+
     /*
      * Returns the height of the image in pixels.
      */
@@ -169,6 +199,11 @@ public:
      * inclusive.
      */
     bool inBounds(double x, double y) const;
+
+    /*
+     * Returns true if the image is in deferred mode (see setDeferred).
+     */
+    bool isDeferred() const;
     
     /*
      * Reads the image's contents from the given image file.
@@ -194,6 +229,16 @@ public:
      */
     void save(const std::string& filename) const;
 
+    /*
+     * Turns deferred mode on or off (default off).
+     * In deferred mode, setRGB, setPixels, fill, fillRegion and clear change
+     * only the local copy of the pixels and grow a dirty region, which goes
+     * to the Java back-end by flush (see above).  Per-pixel programs become
+     * much faster, as they make no back-end call per pixel.
+     * Turning the mode off flushes pending changes.
+     */
+    void setDeferred(bool deferred);
+
     /*
      * Sets the color of the pixel at the given x/y coordinates of the image
      * to the given value.
@@ -207,11 +252,35 @@ public:
     void setRGB(double x, double y, int rgb);
     void setRGB(double x, double y, std::string rgb);
 
+    /*
+     * Sets the colors of a rectangular range of pixels at once.
+     * The one-argument version sets every pixel of the image from a grid of
+     * the same size as the image.
+     * The grid version with x/y copies the grid so that its top-left element
+     * becomes pixel (x, y).
+     * The array version takes width * height colors in row-major order;
+     * a range of whole rows is (0, y, getWidth(), rows, rgb).
+     * Unlike setRGB, the range goes to the Java back-end in a few commands
+     * rather than one per pixel, so a whole frame costs about as much as
+     * a handful of fillRegion calls.
+     * Throws an error if the range goes outside the bounds of the image,
+     * or if the grid size differs from the image size (one-argument version).
+     * Throws an error if any of the rgb values is not a valid color.
+     */
+    void setPixels(const Grid<int>& pixels);
+    void setPixels(double x, double y, const Grid<int>& pixels);
+    void setPixels(double x, double y, double width, double height, const int* rgb);
+
 private:
     double m_width;          // really, these are treated as integers
     double m_height;
     int m_backgroundColor;
     Grid<int> m_pixels;      // row-major; [y][x]
+    bool m_deferred;
+    int m_dirtyLeft;         // pixels changed since last flush, right/bottom exclusive;
+    int m_dirtyTop;          // empty if m_dirtyRight <= m_dirtyLeft
+    int m_dirtyRight;
+    int m_dirtyBottom;
 
     /*
      * Throws an error if the given rgb value is not a valid color.
@@ -228,6 +297,17 @@ private:
      */
     void checkSize(std::string member, double width, double height) const;
 
+    /*
+     * Throws an error if the range of pixels (x, y) through
+     * (x + width - 1, y + height - 1) is out of bounds.
+     */
+    void checkRange(std::string member, double x, double y, double width, double height) const;
+
+    /*
+     * Adds the given rectangle to the dirty region of deferred mode.
+     */
+    void markDirty(int x, int y, int width, int height);
+
     /*
      * Initializes private member variables; called by all constructors.
      */
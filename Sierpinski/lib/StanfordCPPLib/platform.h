@@ -5,6 +5,10 @@
  * the platform-specific parts of the StanfordCPPLib package.  This file is
  * logically part of the implementation and is not interesting to clients.
  *
+ * @version 2026/10/17
+ * - added gbufferedimage_setPixels for bulk pixel upload
+ * - added cpplib_getPipeWritesSaved
+ * - added cpplib_addFlushHook
  * @version 2014/11/14
  * - added method to set unit test runtime in MS
  * @version 2014/10/31
@@ -24,6 +28,7 @@
 #include <string>
 #include <vector>
 #include "gevents.h"
+#include "grid.h"
 #include "gwindow.h"
 #include "point.h"
 #include "sound.h"
@@ -34,6 +39,9 @@ private:
     friend Platform *getPlatform();
 
 public:
+    // function that sends changes held back by a higher-level class
+    typedef void (*FlushHook)();
+
     virtual ~Platform();
     void autograderinput_addButton(std::string text, std::string input = "");
     void autograderinput_addCategory(std::string name);
@@ -46,8 +54,10 @@ public:
     void autograderunittest_setTestResult(const std::string& testName, const std::string& result, bool styleCheck = false);
     void autograderunittest_setTestRuntime(const std::string& testName, int runtimeMS);
     void autograderunittest_setWindowDescriptionText(const std::string& text, bool styleCheck = false);
+    void cpplib_addFlushHook(FlushHook hook);   // run before repaint, pause, event waits and at exit
     std::string cpplib_getCppLibraryVersion();
     std::string cpplib_getJavaBackEndVersion();
+    long long cpplib_getPipeWritesSaved();   // write syscalls saved by buffering commands
     void cpplib_setCppLibraryVersion();
     std::string file_openFileDialog(std::string title, std::string mode, std::string path);
     void filelib_createDirectory(std::string path);
@@ -74,6 +84,7 @@ public:
     std::string gbufferedimage_load(GObject* gobj, const std::string& filename);
     void gbufferedimage_resize(GObject* gobj, double width, double height, bool retain = true);
     std::string gbufferedimage_save(const GObject* const gobj, const std::string& filename);
+    void gbufferedimage_setPixels(GObject* gobj, const Grid<int>& pixels, int x, int y, int width, int height);
     void gbufferedimage_setRGB(GObject* gobj, double x, double y, int rgb);
     void gbutton_constructor(GObject* gobj, std::string label);
     void gcheckbox_constructor(GObject* gobj, std::string label);
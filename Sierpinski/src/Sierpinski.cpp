@@ -1,6 +1,9 @@
 ﻿/********************************************************************************************
 * File: Sierpinski.cpp
 * ----------------------
+* v.4 2026/10/17
+* - triangle sides are calculated apart from drawing (see sierpinskigeometry.h),
+*   so the geometry can be benchmarked without graphics back end
 * v.3 2015/12/24
 * - fields are renamed,
 * - code is reformatted
@@ -12,6 +15,7 @@
 #include "console.h"
 #include "simpio.h"
 #include "gbufferedimage.h"
+#include "sierpinskigeometry.h"
 
 using namespace std;
 
@@ -125,109 +129,16 @@ void setTriangleTopPosition(GWindow& gw,
     vertex_Y = 0.1 * triangleHeight;
 }
 
-/* Function: drawBigTriangle
- * ----------------------
- * Draws main big triangle of the image.
- * Start of drawing begins from topPt.
- * Initiates positions of triangle vertexes into
- * params - rightPt and leftPt.
+/* Function: drawSides
+ * -------------------
+ * Draws every triangle side of the picture.
  *
  * @param gw          Main program window object.
- * @param topPt       Top vertex - start of drawing
- * @param rightPt     righ vertex - value is set in function
- * @param leftPt      left vertex - value is set in function
- * @param length      Triangle side length.        */
-void drawBigTriangle(GWindow& gw,
-             GPoint& topPt,
-             GPoint& rightPt,
-             GPoint& leftPt,
-             int length) {
-
-    rightPt = gw.drawPolarLine(topPt, length, -60);
-    leftPt = gw.drawPolarLine(rightPt, length, 180);
-    gw.drawPolarLine(leftPt, length, 60);
-}
-
-/* Function: getMiddle
- * ----------------------
- * Returns point which is positioned
- * on the middle, between param points. */
-GPoint getMiddle(GPoint& pt1, GPoint& pt2) {
-
-    double x1 = pt1.getX();
-    double y1 = pt1.getY();
-    double x2 = pt2.getX();
-    double y2 = pt2.getY();
-    double middle_x = (x2 + x1) / 2;
-    double middle_y = (y2 + y1) / 2;
-    GPoint pt(middle_x, middle_y);
-    return pt;
-}
-
-/* Function: drawSmallSide
- * -----------------------
- * Draws line between param points.
- * This line is side of the inserted triangle.  */
-void drawSmallSide(GWindow& gw,
-           GPoint& pt1,
-           GPoint& pt2) {
-
-    gw.drawLine(pt1.getX(), pt1.getY(), pt2.getX(), pt2.getY());
-}
-
-/* Function: smallTrianglesDrawing
- * -------------------------
- * Main program recursion. Insert three small
- * triangles inside external biger triangle, while
- * current oreder isn't smaller then input order.
- *
- * @param gw              Main program window object.
- * @param currentOrder    Order of triangles which are inserted yet.
- * @param inputOrder      User order.
- * @param topPt           Top, righ, left edge vertexes
- * @param rightPt         of external bigger triangle.
- * @param leftPt                                                   */
-void smallTrianglesDrawing(GWindow& gw,
-               int currentOrder,
-               int inputOrder,
-               GPoint& topPt,
-               GPoint& rightPt,
-               GPoint& leftPt) {
-
-    if (currentOrder <= inputOrder) {
-        /* Determines middle points of external triangle sides */
-        GPoint rightSideMiddle = getMiddle(rightPt, topPt);
-        GPoint bottomSideMiddle = getMiddle(rightPt, leftPt);
-        GPoint leftSideMiddle = getMiddle(leftPt, topPt);
-        /* Draws top shelf - side of the top inserted triangle */
-        drawSmallSide(gw, leftSideMiddle, rightSideMiddle);
-        /* Draws right shelf - side of the right inserted triangle */
-        drawSmallSide(gw, rightSideMiddle, bottomSideMiddle);
-        /* Draws left shelf - side of the left inserted triangle */
-        drawSmallSide(gw, leftSideMiddle, bottomSideMiddle);
-        /* Update current order for current triangle */
-        currentOrder++;
-        /* Recursively calls top triangle pocess */
-        smallTrianglesDrawing(gw,
-                      currentOrder,
-                      inputOrder,
-                      topPt,
-                      rightSideMiddle,
-                      leftSideMiddle);
-        /* Recursively calls right triangle pocess */
-        smallTrianglesDrawing(gw,
-                      currentOrder,
-                      inputOrder,
-                      rightSideMiddle,
-                      rightPt,
-                      bottomSideMiddle);
-        /* Recursively calls left triangle pocess */
-        smallTrianglesDrawing(gw,
-                      currentOrder,
-                      inputOrder,
-                      leftSideMiddle,
-                      bottomSideMiddle,
-                      leftPt);
+ * @param sides       Lines made by makeSierpinskiTriangle  */
+void drawSides(GWindow& gw, const vector<TriangleSide>& sides) {
+    for (size_t i = 0; i < sides.size(); i++) {
+        const TriangleSide& side = sides[i];
+        gw.drawLine(side.from.x, side.from.y, side.to.x, side.to.y);
     }
 }
 
@@ -247,23 +158,13 @@ int main() {
     /* Adjusts window and set triangle top vertex position */
     setTriangleTopPosition(gw, bigTriangleSideLength, topVertex_X, topVertex_Y);
 
-    GPoint topPt(topVertex_X, topVertex_Y);/* Initiate top vertex */
-    GPoint rightPt;              /* Right vertex */
-    GPoint leftPt;               /* Left vertex */
-    int currentOrder = 0;        /* Current drawing order */
-
-    /* Draws 0-order triangle and initiate rightPt and leftPt  */
-    drawBigTriangle(gw, topPt, rightPt, leftPt, bigTriangleSideLength);
-
-    currentOrder++;
+    PlanePoint topPt(topVertex_X, topVertex_Y);/* Initiate top vertex */
 
-    /* Starts    recursion */
-    smallTrianglesDrawing(gw,
-                  currentOrder,
-                  inputOrder,
-                  topPt,
-                  rightPt,
-                  leftPt);
+    /* Recursively finds sides of 0-order triangle
+     * and of all inserted triangles, then draws them */
+    vector<TriangleSide> sides;
+    makeSierpinskiTriangle(topPt, bigTriangleSideLength, inputOrder, sides);
+    drawSides(gw, sides);
 
     return 0;
 }
@@ -0,0 +1,97 @@
+/********************************************************************************************
+* File: sierpinskigeometry.cpp
+* ----------------------
+* v.1 2026/10/17
+* - sides of Sierpinski triangle are calculated apart from drawing
+*
+* Implementation of the sierpinskigeometry.h interface.
+********************************************************************************************/
+
+#include "sierpinskigeometry.h"
+#include <cmath>
+
+/* Declarations
+ * -----------------------------------------------------------------------------------------*/
+double const DEGREES_TO_RADIANS = 3.14159265358979323846 / 180;
+
+/*------------------------------------------------------------------------------------------//
+ * Implementation section.
+ * -----------------------
+ * 0-order triangle stands on its base: its sides are made from the
+ * top vertex at angles -60, 180 and 60 degrees, the same way as
+ * polar lines of GWindow are drawn.
+ * Every triangle of current order gets inserted triangle with
+ * vertexes at middles of its sides, and three corner triangles
+ * (top, right, left) are split the same way, up to the order.
+ * -----------------------------------------------------------------------------------------*/
+
+/* Function: getPolarPoint
+ * -----------------------
+ * Returns end of line with length r from point p0 at angle
+ * theta degrees counterclockwise from x axis.  */
+static PlanePoint getPolarPoint(const PlanePoint& p0, double r, double theta) {
+    return PlanePoint(p0.x + r * std::cos(theta * DEGREES_TO_RADIANS),
+                      p0.y - r * std::sin(theta * DEGREES_TO_RADIANS));
+}
+
+/* Function: getMiddle
+ * -------------------
+ * Returns point on the middle between points.  */
+static PlanePoint getMiddle(const PlanePoint& pt1, const PlanePoint& pt2) {
+    return PlanePoint((pt2.x + pt1.x) / 2, (pt2.y + pt1.y) / 2);
+}
+
+/* Function: addSide
+ * -----------------
+ * Adds line from one point to another to sides.  */
+static void addSide(const PlanePoint& from,
+                    const PlanePoint& to,
+                    std::vector<TriangleSide>& sides) {
+    TriangleSide side;
+    side.from = from;
+    side.to = to;
+    sides.push_back(side);
+}
+
+/* Function: insertTriangles
+ * -------------------------
+ * Adds sides of triangle inserted into triangle topPt, rightPt,
+ * leftPt, and recursively - into its corner triangles, while
+ * currentOrder isn't bigger than order. Returns quantity of
+ * inserted triangles.  */
+static long long insertTriangles(int currentOrder,
+                                 int order,
+                                 const PlanePoint& topPt,
+                                 const PlanePoint& rightPt,
+                                 const PlanePoint& leftPt,
+                                 std::vector<TriangleSide>& sides) {
+    if (currentOrder > order) {
+        return 0;
+    }
+    PlanePoint rightSideMiddle = getMiddle(rightPt, topPt);
+    PlanePoint bottomSideMiddle = getMiddle(rightPt, leftPt);
+    PlanePoint leftSideMiddle = getMiddle(leftPt, topPt);
+    addSide(leftSideMiddle, rightSideMiddle, sides);
+    addSide(rightSideMiddle, bottomSideMiddle, sides);
+    addSide(leftSideMiddle, bottomSideMiddle, sides);
+    currentOrder++;
+    long long count = 1;
+    count += insertTriangles(currentOrder, order, topPt, rightSideMiddle, leftSideMiddle, sides);
+    count += insertTriangles(currentOrder, order, rightSideMiddle, rightPt, bottomSideMiddle,
+                             sides);
+    count += insertTriangles(currentOrder, order, leftSideMiddle, bottomSideMiddle, leftPt, sides);
+    return count;
+}
+
+long long makeSierpinskiTriangle(const PlanePoint& top,
+                                 double length,
+                                 int order,
+                                 std::vector<TriangleSide>& sides) {
+    sides.clear();
+    PlanePoint rightPt = getPolarPoint(top, length, -60);
+    PlanePoint leftPt = getPolarPoint(rightPt, length, 180);
+    addSide(top, rightPt, sides);
+    addSide(rightPt, leftPt, sides);
+    addSide(leftPt, top, sides);
+    return insertTriangles(1, order, top, rightPt, leftPt, sides);
+}
@@ -0,0 +1,50 @@
+/********************************************************************************************
+* File: sierpinskigeometry.h
+* ----------------------
+* v.1 2026/10/17
+* - sides of Sierpinski triangle are calculated apart from drawing
+*
+* Geometry of the Sierpinski triangle, without graphics library.
+********************************************************************************************/
+
+#ifndef _sierpinskigeometry_h
+#define _sierpinskigeometry_h
+
+#include <vector>
+
+/* Type: PlanePoint
+ * ----------------
+ * Point of the window plane, y axis goes down.  */
+struct PlanePoint {
+    double x;
+    double y;
+
+    PlanePoint() : x(0), y(0) {}
+    PlanePoint(double x, double y) : x(x), y(y) {}
+};
+
+/* Type: TriangleSide
+ * ------------------
+ * Line from one vertex of triangle to another.  */
+struct TriangleSide {
+    PlanePoint from;
+    PlanePoint to;
+};
+
+/* Function: makeSierpinskiTriangle
+ * --------------------------------
+ * Fills sides with lines of Sierpinski triangle: 3 sides of
+ * 0-order triangle, and then 3 sides of every inserted triangle
+ * of orders 1 ... order, in the order of recursive drawing.
+ * Returns quantity of inserted triangles, (3^order - 1) / 2.
+ *
+ * @param top       Top vertex of 0-order triangle
+ * @param length    0-order triangle side length
+ * @param order     Sierpinski order, 0 - only 0-order triangle
+ * @param sides     Output lines, old content is removed  */
+long long makeSierpinskiTriangle(const PlanePoint& top,
+                                 double length,
+                                 int order,
+                                 std::vector<TriangleSide>& sides);
+
+#endif